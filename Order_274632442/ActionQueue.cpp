@@ -0,0 +1,49 @@
+
+#include <exception>
+#include <iostream>
+#include <string>
+
+#include "ActionQueue.h"
+#include "BingoGame.h"
+#include "ScreenDisplay.h"
+
+#include "Exceptions.h"
+
+ActionQueue::ActionQueue(BingoGame* game, unsigned capacity)
+  : _game{game}, _queue{capacity} {
+  if (game == nullptr) {
+    throw bad_input("Game cannot be a nullptr.");
+  }
+}
+
+ActionQueue::~ActionQueue() {}
+
+bool ActionQueue::post(const BingoGame::playerAction& action) {
+  BingoGame::playerAction item = action;
+  return _queue.push(item);
+}
+
+unsigned ActionQueue::drain(std::ostream& out, unsigned maxActions) {
+  BingoGame::playerAction batch[BATCH_SIZE];
+  unsigned total = 0;
+  while (total < maxActions) {
+    unsigned limit = maxActions - total;
+    if (limit > BATCH_SIZE) {
+      limit = BATCH_SIZE;
+    }
+    unsigned count = _queue.popBatch(batch, limit);
+    for (unsigned i = 0; i < count; ++i) {
+      try {
+        _game->takeAction(out, batch[i]);
+      } catch (const std::exception& e) {
+        ScreenDisplay screen;
+        screen.displayCallerMessage(out, std::string(e.what()) + "\n");
+      }
+    }
+    total += count;
+    if (count < BATCH_SIZE) {
+      break;
+    }
+  }
+  return total;
+}
@@ -0,0 +1,69 @@
+
+#ifndef ACTION_QUEUE_H_INCLUDED
+#define ACTION_QUEUE_H_INCLUDED
+
+#include <iostream>
+
+#include "BingoGame.h"
+#include "MpscQueue.h"
+
+/**
+* @class ActionQueue ActionQueue.h "ActionQueue.h"
+* @brief The moves waiting for one room's BingoGame.
+* @details Network and I/O threads post parsed actions from any thread and
+*   never touch or wait on the game. The thread that owns the game drains
+*   the queue between calls, applying the actions in batches and in the
+*   order they were posted. A failed action is reported to the room and
+*   does not stop the batch.
+*/
+class ActionQueue {
+ public:
+  /**
+  * @brief Constructor.
+  * @param [in] game The game the actions are for.
+  * @param [in] capacity The number of actions that can wait.
+  * @throw bad_input If game is a nullptr.
+  */
+  explicit ActionQueue(BingoGame* game, unsigned capacity = 4096);
+
+  /**
+  * @brief Copy constructor, disabled.
+  * @param rv an ActionQueue class object.
+  */
+  ActionQueue(const ActionQueue& rv) = delete;
+
+  /**
+  * @brief Assignment operator, disabled.
+  * @param rv an ActionQueue class object.
+  */
+  void operator=(const ActionQueue& rv) = delete;
+
+  /**
+  * @brief Destructor.
+  */
+  virtual ~ActionQueue();
+
+  /**
+  * @brief Queue an action, from any thread, without blocking.
+  * @param [in] action The action.
+  * @return true, if the action is queued, false if the queue is full.
+  */
+  bool post(const BingoGame::playerAction& action);
+
+  /**
+  * @brief Apply the queued actions, only called by the game's owner.
+  * @param [inout] out Insert prompts and information in this ostream.
+  * @param [in] maxActions The most actions to apply.
+  * @return The number of actions taken from the queue.
+  */
+  unsigned drain(std::ostream& out, unsigned maxActions = ~0u);
+
+  /**< The number of actions taken from the queue at a time. >**/
+  static const unsigned BATCH_SIZE = 64;
+
+ private:
+  BingoGame* _game;
+  MpscQueue<BingoGame::playerAction> _queue;
+};
+
+#endif // ACTION_QUEUE_H_INCLUDED
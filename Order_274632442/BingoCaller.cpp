@@ -1,21 +1,54 @@
 
 #include <algorithm>
-#include <iterator>
-#include <fstream>
+#include <cstdint>
 #include <string>
-#include <sstream>
+#include <utility>
 #include <vector>
 
 #include "BingoCaller.h"
 #include "BingoTypes.h"
+#include "GameSpec.h"
 #include "MakeRandomInt.h"
 #include "Exceptions.h"
 
-BingoCaller::BingoCaller(BingoTypes::victoryType victory)
-  : _victory{victory} {
-  _currentBall = _ballsChosen.end();
+namespace {
+
+/**
+* @brief Pick a clue for the ball drawn at ordinal in the game (seed,
+*   gameId), without drawing from the game's stream.
+* @details One Philox block keyed by the seed, in a counter domain the
+*   draws of the game never reach.
+* @param [in] seed The seed of the set of games.
+* @param [in] gameId The id of the game in the set.
+* @param [in] ordinal The draw ordinal of the ball.
+* @param [in] numClues The number of clues for a ball.
+* @return A value in [0, numClues).
+*/
+unsigned clueOf(std::uint64_t seed, std::uint64_t gameId, unsigned ordinal,
+                unsigned numClues) {
+  const std::uint32_t CLUE_DOMAIN = 0xffffffffu;
+  std::uint32_t key[2] = {
+    static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)
+  };
+  std::uint32_t ctr[4] = {
+    ordinal, CLUE_DOMAIN, static_cast<std::uint32_t>(gameId),
+    static_cast<std::uint32_t>(gameId >> 32)
+  };
+  Philox4x32::block(ctr, key);
+  return static_cast<unsigned>((std::uint64_t{ctr[0]} * numClues) >> 32);
 }
 
+}  // namespace
+
+BoardView::BoardView(std::shared_ptr<const char[]> buffer, unsigned length,
+                     unsigned long version)
+  : _buffer{std::move(buffer)}, _length{length}, _version{version} {}
+
+BingoCaller::BingoCaller(BingoTypes::victoryType victory)
+  : _ordinal{}, _called{}, _numBalls{0}, _numPulled{0}, _isDrawn{false},
+    _victory{victory}, _info{nullptr}, _board{new char[BOARD_SIZE]},
+    _boardLength{0}, _boardVersion{0} {}
+
 BingoCaller::~BingoCaller() {}
 
 BingoTypes::victoryType BingoCaller::getVictoryType() {
@@ -27,229 +60,298 @@ BingoTypes::gameType BingoCaller::getGameType() {
 }
 
 unsigned BingoCaller::getNumBalls() {
-  return static_cast<unsigned>(_game);
+  return _numBalls;
 }
 
 unsigned BingoCaller::getNumBallsPulled() {
-  return _ballsChosen.size();
+  return _numPulled;
 }
 
 unsigned BingoCaller::getNumBallsInCage() {
-  return _ballCage.size();
+  return _numBalls - _numPulled;
 }
 
 std::string BingoCaller::listPulledBalls() {
-  std::string list;
-  if (!_ballsChosen.empty()) {
-    for (auto it = _ballsChosen.begin(); it != _ballsChosen.end(); ++it) {
-      if (it != _ballsChosen.begin()) {
-        list += ", ";
-      }
-      list += makeList({*it});
-    }
+  if (_boardLength == 0) {
+    return "No balls have been pulled.";
   }
-  return list;
+  return std::string(_board.get(), _boardLength);
+}
+
+BoardView BingoCaller::getBoard() {
+  return BoardView(_board, _boardLength, _boardVersion);
 }
 
 std::string BingoCaller::listUnpulledBalls() {
-  std::string list;
-  if (!_ballCage.empty()) {
-    for (auto it = _ballCage.begin(); it != _ballCage.end(); ++it) {
-      if (it != _ballCage.begin()) {
-        list += ", ";
-      }
-      list += makeList({*it});
-    }
+  if (_numPulled == _numBalls) {
+    return "No balls are left in the cage.";
   }
-  return list;
+  std::vector<unsigned> cage(_balls + _numPulled, _balls + _numBalls);
+  std::sort(cage.begin(), cage.end());
+  return makeList(cage);
 }
 
-
 void BingoCaller::setVictoryType(BingoTypes::victoryType victory) {
+  if (_numPulled != 0) {
+    throw function_unavailable
+    ("The victory type cannot be changed during a game.");
+  }
   _victory = victory;
 }
 
 bool BingoCaller::pullBall() {
-  if (_ballCage.empty()) {
+  if (_numPulled == _numBalls) {
     return false;
   }
 
-  // Use MakeRandomInt to get a random index
-  auto index = MakeRandomInt::getInstance().getValue(_ballCage.size());
+  if (!_isDrawn) {
+    unsigned pick = _numPulled +
+      random().getValue(_numBalls - _numPulled);
+    std::swap(_balls[_numPulled], _balls[pick]);
+  }
+  unsigned ball = _balls[_numPulled];
+  _called[ball / 64] |= std::uint64_t{1} << (ball % 64);
+  _ordinal[ball] = ++_numPulled;
+  appendToBoard(ball);
 
-  // Use iterator to avoid invalidating iterators
-  auto it = _ballCage.begin() + index;
-  unsigned pulledBall = *it;
+  return true;
+}
 
-  _ballsChosen.push_back(pulledBall);
-  _ballCage.erase(it);
+bool BingoCaller::pullBall(unsigned ball) {
+  unsigned pick = _numPulled;
+  while (pick < _numBalls && _balls[pick] != ball) {
+    ++pick;
+  }
+  if (pick == _numBalls) {
+    return false;
+  }
 
-  _currentBall = _ballsChosen.end();
+  std::swap(_balls[_numPulled], _balls[pick]);
+  _called[ball / 64] |= std::uint64_t{1} << (ball % 64);
+  _ordinal[ball] = ++_numPulled;
+  appendToBoard(ball);
 
   return true;
 }
 
-unsigned BingoCaller::getCurrentNumber() {
-  if (_currentBall == _ballsChosen.end()) {
-    throw std::invalid_size("No balls pulled yet.");
+void BingoCaller::drawSequence() {
+  MakeRandomInt& randInt = random();
+  for (unsigned i = _numPulled; i + 1 < _numBalls; ++i) {
+    unsigned pick = i + randInt.getValue(_numBalls - i);
+    std::swap(_balls[i], _balls[pick]);
   }
-  return *_currentBall;
+  _isDrawn = true;
 }
 
-
-bool BingoCaller::wasNumberCalled(unsigned number) {
-  return std::find(_ballsChosen.begin(), _ballsChosen.end(), number) != _ballsChosen.end();
+const unsigned char* BingoCaller::getSequence() {
+  return _balls;
 }
 
-void BingoCaller::resetGame() {
-  _ballsChosen.clear();
-  _ballCage.clear();
-  for (unsigned i = 1; i <= _game; ++i) {
-    _ballCage.push_back(i);
+unsigned BingoCaller::getCurrentNumber() {
+  if (_numPulled == 0) {
+    throw invalid_size("No balls pulled yet.");
   }
-  _currentBall = _ballsChosen.end();
+  return _balls[_numPulled - 1];
 }
 
+bool BingoCaller::wasNumberCalled(unsigned number) {
+  if (_info == nullptr || !_info->isValidBall(number)) {
+    throw bad_input("The number is not a ball of this game.");
+  }
+  return (_called[number / 64] >> (number % 64)) & 1;
+}
 
-Bingo50Caller::Bingo50Caller(std::string cluesFile, BingoTypes::victoryType victory)
-    : BingoCaller(victory) {
-    // Fill _ballCage with all valid balls for BINGO50
-    for (unsigned i = 1; i <= 50; ++i) {
-        _ballCage.push_back(i);
-    }
-    _game = BingoTypes::BINGO50;
-    _description = "Bingo 50";
-    readClues(cluesFile);
+const BingoTypes::ballMask& BingoCaller::calledMask() {
+  return _called;
 }
 
+unsigned BingoCaller::getDrawOrdinal(unsigned number) {
+  if (_info == nullptr || !_info->isValidBall(number)) {
+    throw bad_input("The number is not a ball of this game.");
+  }
+  return _ordinal[number];
+}
 
-char Bingo50Caller::getLetter(unsigned value) {
-  // Assuming letters B, I, N, G, O correspond to ball ranges
-  if (value >= 1 && value <= 15) return 'B';
-  if (value >= 16 && value <= 30) return 'I';
-  if (value >= 31 && value <= 45) return 'N';
-  if (value >= 46 && value <= 60) return 'G';
-  if (value >= 61 && value <= 75) return 'O';
-  throw BingoException("Invalid ball value.");
+void BingoCaller::resetGame() {
+  for (unsigned i = 0; i < _numPulled; ++i) {
+    _ordinal[_balls[i]] = 0;
+  }
+  _called = BingoTypes::ballMask{};
+  _numPulled = 0;
+  _isDrawn = false;
+  clearBoard();
 }
 
-Bingo50Caller::Bingo50Caller(BingoTypes::victoryType victory)
-  : Bingo50Caller{"data/bingo50calls.csv", victory} {}
+void BingoCaller::saveState(callerState& state) {
+  std::copy(_balls, _balls + BingoTypes::MAX_BALLS, state.balls);
+  state.numPulled = _numPulled;
+  state.game = _game;
+  state.victory = _victory;
+  state.isDrawn = _isDrawn;
+  state.hasStream = _random != nullptr;
+  if (_random) {
+    state.random = _random->getState();
+  }
+}
 
-Bingo50Caller::Bingo50Caller(std::string cluesFile, BingoTypes::victoryType victory)
-  : BingoCaller{victory} {
-  // Initialize _ballCage with all valid balls for BINGO50
-  for (unsigned i = 1; i <= 50; ++i) {
-    _ballCage.push_back(i);
+void BingoCaller::restoreState(const callerState& state) {
+  if (state.game != _game) {
+    throw card_to_game_mismatch("The saved game is of another game type.");
+  }
+  bool seen[BingoTypes::MAX_BALLS] = {};
+  for (unsigned i = 0; i < _numBalls; ++i) {
+    unsigned ball = state.balls[i];
+    if (ball < 1 || ball > _numBalls || seen[ball]) {
+      throw bad_input("The saved balls are not the balls of the game.");
+    }
+    seen[ball] = true;
+  }
+  if (state.numPulled > _numBalls) {
+    throw bad_input("The saved balls are not the balls of the game.");
   }
-  _game = BingoTypes::BINGO50;
-  _description = "Bingo 50";
 
-  // Ensure a default clues file is provided, otherwise throw an exception
-  if (cluesFile.empty()) {
-    throw BingoException("Clues file cannot be empty.");
+  fillCage(_info);
+  std::copy(state.balls, state.balls + _numBalls, _balls);
+  for (unsigned i = 0; i < state.numPulled; ++i) {
+    unsigned ball = _balls[i];
+    _called[ball / 64] |= std::uint64_t{1} << (ball % 64);
+    _ordinal[ball] = i + 1;
+    appendToBoard(ball);
+  }
+  _numPulled = state.numPulled;
+  _isDrawn = state.isDrawn;
+  _victory = state.victory;
+
+  if (!state.hasStream) {
+    _random.reset();
+  } else {
+    if (!_random) {
+      _random.reset(new MakeRandomInt(0, 0));
+    }
+    _random->setState(state.random);
   }
+}
 
-  // Call readClues to populate clues from the specified file
-  readClues(cluesFile);
+void BingoCaller::setGameStream(std::uint64_t seed, std::uint64_t gameId) {
+  fillCage(_info);
+  if (_random) {
+    _random->seed(seed, gameId);
+  } else {
+    _random.reset(new MakeRandomInt(seed, gameId));
+  }
 }
 
+std::string BingoCaller::makeList(const std::vector<unsigned>& balls) {
+  if (balls.empty()) {
+    throw invalid_size("There are no balls to list.");
+  }
 
-Bingo50Caller::~Bingo50Caller() {
-  if (_clues != nullptr) {
-    for (unsigned i = 0; i < 50; ++i) { // Assuming 50 values due to lack of information
-      delete[] _clues[i];
+  std::string list;
+  list.reserve(balls.size() * (_info->labelSize + 1));
+  for (unsigned i = 0; i < balls.size(); ++i) {
+    if (i != 0) {
+      list += ',';
     }
-    delete[] _clues;
+    list += getLabel(balls[i]);
   }
-  // Deallocate memory for the numClues array
-  delete[] _numClues;
+  return list;
 }
 
-
-std::string Bingo50Caller::getAnnouncement() {
-  // Implement announcement logic for Bingo50 game
-  if (_currentBall == _ballsChosen.end()) {
-    throw BingoException("No ball has been pulled yet.");
+void BingoCaller::fillCage(const GameInfo* info) {
+  _info = info;
+  _game = info->game;
+  _numBalls = info->numBalls;
+  for (unsigned i = 0; i < _numBalls; ++i) {
+    _balls[i] = i + 1;
+    _ordinal[i + 1] = 0;
   }
-
-  // Randomly select an announcement from the clues for the pulled ball
-  unsigned ball = *_currentBall;
-  int randomClueIndex = MakeRandomInt::getInstance().getValue(_numClues[ball - 1]);
-  return _clues[ball - 1][randomClueIndex];
+  _called = BingoTypes::ballMask{};
+  _numPulled = 0;
+  _isDrawn = false;
+  clearBoard();
 }
 
-void Bingo50Caller::readClues(std::string cluesFile) {
-  // Implement reading clues from file for Bingo50 game
-  std::ifstream file(cluesFile);
-  if (!file.is_open()) {
-    throw BingoException("Could not open clues file: " + cluesFile);
+void BingoCaller::appendToBoard(unsigned ball) {
+  char* end = _board.get() + _boardLength;
+  if (_boardLength != 0) {
+    *end++ = ',';
   }
+  std::string_view label = _info->label(ball);
+  end = std::copy(label.begin(), label.end(), end);
+  _boardLength = end - _board.get();
+  ++_boardVersion;
+}
 
-  // Read the number of values and clues per value
-  unsigned numValues, numClues;
-  file >> numValues >> numClues;
-  if (numValues != 50 || numClues < 1 || numClues > 10) {
-    throw BingoException("Invalid format in clues file: " + cluesFile);
+void BingoCaller::clearBoard() {
+  if (_board.use_count() > 1) {
+    _board.reset(new char[BOARD_SIZE]);
   }
+  _boardLength = 0;
+  ++_boardVersion;
+}
 
-  // Allocate memory for the clues array
-  _clues = new std::string*[numValues];
-  for (unsigned i = 0; i < numValues; ++i) {
-    _clues[i] = new std::string[numClues];
+char BingoCaller::getLetter(unsigned value) {
+  if (_info == nullptr || !_info->isValidBall(value)) {
+    throw bad_input("The value is not a ball of this game.");
   }
-  _numClues = new unsigned[numValues];
+  return _info->letters[value];
+}
 
-  // Read the clues for each value
-  for (unsigned i = 0; i < numValues; ++i) {
-    unsigned value;
-    file >> value;
-    if (value != i + 1) {
-      throw BingoException("Invalid format in clues file: " + cluesFile);
-    }
-    _numClues[i] = numClues;
-    for (unsigned j = 0; j < numClues; ++j) {
-      std::string clue;
-      std::getline(file, clue); // Read entire line including spaces
-      _clues[i][j] = clue;
-    }
+std::string_view BingoCaller::getLabel(unsigned value) {
+  if (_info == nullptr || !_info->isValidBall(value)) {
+    throw bad_input("The value is not a ball of this game.");
   }
+  return _info->label(value);
+}
 
-  file.close();
+Bingo50Caller::Bingo50Caller(BingoTypes::victoryType victory)
+  : Bingo50Caller{ClueTable::embedded("bingo50calls",
+                                      Bingo50Spec::NUM_BALLS), victory} {}
+
+Bingo50Caller::Bingo50Caller(ClueTable clues,
+                             BingoTypes::victoryType victory)
+  : BingoCaller{victory}, _clues{std::move(clues)} {
+  if (_clues.getNumValues() != Bingo50Spec::NUM_BALLS) {
+    throw bad_input("The clues must have a line for each of the 50 values.");
+  }
+  fillCage(&Bingo50Spec::INFO);
+  _description = "Bingo 50";
 }
 
-Bingo75Caller::Bingo75Caller(BingoTypes::victoryType victory)
+Bingo50Caller::Bingo50Caller(std::string cluesFile,
+                             BingoTypes::victoryType victory)
   : BingoCaller{victory} {
-  // Fill _ballCage with all valid balls for BINGO75
-  for (unsigned i = 1; i <= 75; ++i) {
-    _ballCage.push_back(i);
-  }
-  _game = BingoTypes::BINGO75;
-  _description = "Bingo 75";
+  fillCage(&Bingo50Spec::INFO);
+  _description = "Bingo 50";
+  readClues(cluesFile);
 }
 
-std::string Bingo75Caller::getAnnouncement() {
-  // Implement announcement logic for Bingo75 game
-  if (_currentBall == _ballsChosen.end()) {
-    throw BingoException("No ball has been pulled yet.");
+Bingo50Caller::~Bingo50Caller() {}
+
+std::string_view Bingo50Caller::getAnnouncement() {
+  unsigned ball = getCurrentNumber();
+  unsigned clue;
+  if (_random) {
+    clue = clueOf(_random->getSeed(), _random->getStream(), _numPulled,
+                  _clues.getNumClues());
+  } else {
+    clue = random().getValue(_clues.getNumClues());
   }
+  return _clues.getClue(ball, clue);
+}
 
-  unsigned ball = *_currentBall;
-  char letter = getLetter(ball);
-  return "Letter " + std::to_string(letter) + ", Number " + std::to_string(ball);
+void Bingo50Caller::readClues(std::string cluesFile) {
+  _clues = ClueTable::readFile(cluesFile, Bingo50Spec::NUM_BALLS);
 }
 
-Bingo75Caller::~Bingo75Caller() {
-  // No specific cleanup needed for Bingo75Caller
+Bingo75Caller::Bingo75Caller(BingoTypes::victoryType victory)
+  : BingoCaller{victory} {
+  fillCage(&Bingo75Spec::INFO);
+  _description = "Bingo 75";
 }
 
-std::string Bingo75Caller::getAnnouncement() {
-  // Implement announcement logic for Bingo75 game
-  if (_currentBall == _ballsChosen.end()) {
-    throw BingoException("No ball has been pulled yet.");
-  }
+Bingo75Caller::~Bingo75Caller() {}
 
-  unsigned ball = *_currentBall;
-  char letter = getLetter(ball);
-  return "Letter " + std::to_string(letter) + ", Number " + std::to_string(ball);
-}
\ No newline at end of file
+std::string_view Bingo75Caller::getAnnouncement() {
+  return Bingo75Spec::INFO.announcement(getCurrentNumber());
+}
@@ -2,10 +2,59 @@
 #ifndef BINGOCALLER_H_INCLUDED
 #define BINGOCALLER_H_INCLUDED
 
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "BingoTypes.h"
+#include "ClueTable.h"
+#include "GameSpec.h"
+#include "MakeRandomInt.h"
+
+/**
+ * @class BoardView BingoCaller.h "BingoCaller.h"
+ * @brief A read only view of the rendered board of called balls.
+ * @details The view shares the caller's board buffer, which only grows
+ *   during a game, so the text of a view never changes, even after later
+ *   pulls or a reset. Views taken at the same ball hold the same bytes and
+ *   the same version.
+ */
+class BoardView {
+ public:
+  /**
+  * @brief Constructor.
+  * @param [in] buffer The shared board buffer.
+  * @param [in] length The number of bytes of buffer in the view.
+  * @param [in] version The version of the board.
+  */
+  BoardView(std::shared_ptr<const char[]> buffer, unsigned length,
+            unsigned long version);
+
+  /**
+  * @brief Access the rendered board, "B:07,I:22" and so on.
+  * @return The text of the board.
+  */
+  std::string_view getText() const {
+    return std::string_view(_buffer.get(), _length);
+  }
+
+  /**
+  * @brief Access the version of the board.
+  * @details The version changes with every pull and every reset, so two
+  *   views with the same version have the same text.
+  * @return The version.
+  */
+  unsigned long getVersion() const {
+    return _version;
+  }
+
+ private:
+  std::shared_ptr<const char[]> _buffer;
+  unsigned _length;
+  unsigned long _version;
+};
 
 /**
  * @class BingoCaller BingoCaller.h "BingoCaller.h"
@@ -13,10 +62,26 @@
  */
 class BingoCaller {
  public:
+  /**
+  * @brief The state of a game's draw, plain bytes that can be saved and
+  *   loaded.
+  */
+  struct callerState {
+    /**< The called balls in draw order, then the cage. >**/
+    unsigned char balls[BingoTypes::MAX_BALLS];
+    unsigned numPulled;
+    BingoTypes::gameType game;
+    BingoTypes::victoryType victory;
+    bool isDrawn;
+    /**< Whether the game has its own stream, in random. >**/
+    bool hasStream;
+    MakeRandomInt::engineState random;
+  };
+
   /**
   * @brief Default constructor.
-  * @details Sets victoryType from parameter, sets _currentBall to the end of
-  *   the _ballsChosen list.
+  * @details Sets victoryType from parameter, the cage is empty until a
+  *   subclass fills it.
   * @param [in] victory The victoryType for this game.
   */
   BingoCaller(BingoTypes::victoryType victory = BingoTypes::HORIZONTAL_LINE);
@@ -58,10 +123,13 @@ class BingoCaller {
 
   /**
   * @brief Get the announcement.
-  * @return The caller's announcement for the current ball.
-  * @throw invalid_size if _ballsChosen is empty.
+  * @details The text lives in a table of the caller or its game, so
+  *   announcing a ball allocates and formats nothing.
+  * @return The caller's announcement for the current ball, valid as long
+  *   as the caller.
+  * @throw invalid_size if no balls have been pulled.
   */
-  virtual std::string getAnnouncement() = 0;
+  virtual std::string_view getAnnouncement() = 0;
 
   /**
   * @brief Get the most recent numberCalled.
@@ -72,6 +140,7 @@ class BingoCaller {
 
   /**
   * @brief Determine if a number was called.
+  * @details A single bit test in the called ball mask.
   * @param [in] number The number of interest.
   * @return true, if the number was found in balls chosen, otherwise false.
   * @throw bad_input If the number is outside the range of
@@ -80,11 +149,38 @@ class BingoCaller {
   bool wasNumberCalled(unsigned number);
 
   /**
-  * @brief Make a list of all the balls for called numbers, use makeList.
+  * @brief Access the set of called balls.
+  * @details Bit n is set if ball n was called, so a whole card can be
+  *   checked against the calls with a few bitwise operations.
+  * @return The called ball mask, it changes with each pull.
+  */
+  const BingoTypes::ballMask& calledMask();
+
+  /**
+  * @brief Access when a number was called.
+  * @param [in] number The number of interest.
+  * @return 1 for the first ball pulled, 2 for the second and so on, 0 if
+  *   the number has not been called.
+  * @throw bad_input If the number is outside the range of valid numbers.
+  */
+  unsigned getDrawOrdinal(unsigned number);
+
+  /**
+  * @brief Make a list of all the balls for called numbers.
+  * @details A copy of the text of getBoard, or a message if no balls have
+  *   been pulled.
   * @return A list in a string.
   */
   std::string listPulledBalls();
 
+  /**
+  * @brief Access the board of called balls.
+  * @details The board is rendered as the balls are pulled, one "X:99" label
+  *   per pull, so a view costs no formatting.
+  * @return A view of the board at the current ball.
+  */
+  BoardView getBoard();
+
   /**
   * @brief Make a list of all the balls in the cage, use makeList.
   * @return A list in a string.
@@ -101,51 +197,160 @@ class BingoCaller {
 
   /**
   * @brief Pull a ball from the ballCage.
-  * @details Randomly select a ball from the cage, remove the item from the
-  *   ballCage and add it to the ballsChosen, then update the currentBall.
+  * @details Randomly select a ball from the cage and swap it with the first
+  *   ball in the cage, which then becomes the current ball. A pull is one
+  *   random number and a swap. After drawSequence the balls are taken in
+  *   the drawn order.
   * @return true, if a ball was pulled, false if no balls are left.
   */
   bool pullBall();
 
+  /**
+  * @brief Pull a given ball from the ballCage, e.g. to replay a game.
+  * @details The ball is swapped with the first ball in the cage, no random
+  *   number is drawn.
+  * @param [in] ball The ball.
+  * @return true, if the ball was pulled, false if it isn't in the cage.
+  */
+  bool pullBall(unsigned ball);
+
+  /**
+  * @brief Draw the order of all the balls left in the cage now.
+  * @details The cage is shuffled once with Fisher-Yates, later pulls take
+  *   the balls in that order without a random number. Used to simulate
+  *   whole games and to run games drawn in advance.
+  */
+  void drawSequence();
+
+  /**
+  * @brief Access the balls in the order they are pulled.
+  * @details The first getNumBallsPulled entries are the called balls. The
+  *   rest are the cage, which is in draw order only after drawSequence.
+  * @return A pointer to getNumBalls ball values.
+  */
+  const unsigned char* getSequence();
+
   /**
   * @brief Reset the caller to start a new game.
-  * @details Move all the balls into the cage, set the current ball to 0.
+  * @details Move all the balls into the cage. The balls are not put back in
+  *   order, each pull picks from the cage at random.
   */
   void resetGame();
 
+  /**
+  * @brief Save the state of the game's draw.
+  * @param [out] state The balls, the victory type and the game's stream,
+  *   random is left alone if the game has no stream.
+  */
+  void saveState(callerState& state);
+
+  /**
+  * @brief Continue a game from a saved draw.
+  * @details The called set, the draw ordinals and the board are rebuilt
+  *   from the balls. A game that drew from the thread's generator goes on
+  *   drawing from it.
+  * @param [in] state A state from saveState.
+  * @throw card_to_game_mismatch If state is of another game type.
+  * @throw bad_input If the balls are not the balls of the game.
+  */
+  void restoreState(const callerState& state);
+
+  /**
+  * @brief Start a game whose draws come from the counter based stream
+  *   (seed, gameId).
+  * @details The balls are put back in order and every later pull, until
+  *   the next call, draws from this stream. The same seed and gameId give
+  *   the same sequence on any thread.
+  * @param [in] seed The seed of the set of games.
+  * @param [in] gameId The id of the game in the set.
+  */
+  void setGameStream(std::uint64_t seed, std::uint64_t gameId);
+
  protected:
-  std::vector<unsigned> _ballCage;
-  std::vector<unsigned> _ballsChosen;
-  std::vector<unsigned>::iterator _currentBall;
+  /**< [0, _numPulled) are called in draw order, then the cage. >**/
+  unsigned char _balls[BingoTypes::MAX_BALLS];
+  /**< The draw ordinal of each ball, 0 for balls in the cage. >**/
+  unsigned char _ordinal[BingoTypes::MAX_BALLS];
+  BingoTypes::ballMask _called;
+  unsigned _numBalls;
+  unsigned _numPulled;
+  bool _isDrawn;
   std::string _description;
   BingoTypes::gameType _game;
   BingoTypes::victoryType _victory;
+  const GameInfo* _info;
+  /**< The called balls rendered as in makeList, shared with BoardViews. >**/
+  std::shared_ptr<char[]> _board;
+  unsigned _boardLength;
+  unsigned long _boardVersion;
+  /**< The keyed stream of this game, nullptr to use the thread's. >**/
+  std::unique_ptr<MakeRandomInt> _random;
+
+  /**
+  * @brief Access the random values this game draws from.
+  * @return The game's stream if set, else this thread's MakeRandomInt.
+  */
+  MakeRandomInt& random() {
+    return _random ? *_random : MakeRandomInt::getInstance();
+  }
 
   /**
   * @brief Make a list of the balls in the given list with at least one entry.
   * @details A comma delimited list each item given in X:99 format. ie: B:01.
+  *   The items are copied from the label table of the game.
   * @param [in] balls The list containing the balls to be listed.
   * @return A string containing the list.
   * @throw invalid_size if the list is empty.
   */
   std::string makeList(const std::vector<unsigned>& balls);
 
+  /**
+  * @brief Set the game type and put all its balls in the cage.
+  * @param [in] info The GameInfo of the game type.
+  */
+  void fillCage(const GameInfo* info);
+
+  /**
+  * @brief Add the label of ball to the board.
+  * @param [in] ball The ball just pulled.
+  */
+  void appendToBoard(unsigned ball);
+
+  /**
+  * @brief Empty the board, in a new buffer if views still share the old.
+  */
+  void clearBoard();
+
+  /**< Room for "," and "X:999" for every ball. >**/
+  static const unsigned BOARD_SIZE = BingoTypes::MAX_BALLS * 6;
+
   /**
   * @brief Returns the appropriate letter of BINGO for the given value.
-  * @details The value letter relationship is dependant on the gameType.
-  *   The first fifth of the valid number range is under the B, the second
-  *   fifth is under I and so on.
+  * @details The value letter relationship is dependant on the gameType and
+  *   is read from the letter table of its GameSpec. The first fifth of the
+  *   valid number range is under the B, the second fifth is under I and so
+  *   on.
   * @param [in] value the value of a number square or ball
   * @return The appropriate letter of BINGO.
   * @throw bad_input If the value is not in the valid number range for the gameType.
   */
   char getLetter(unsigned value);
+
+  /**
+  * @brief Returns the label of a ball, as listed by makeList.
+  * @param [in] value the value of a ball
+  * @return "B:07" and so on, a view of the game's label table.
+  * @throw bad_input If the value is not in the valid number range for the
+  *   gameType.
+  */
+  std::string_view getLabel(unsigned value);
 };
 
 
 /**
  * @class Bingo50Caller BingoCaller.h "BingoCaller.h"
- * @brief Bingo caller for a game with 50 balls that reads the clues from a file.
+ * @brief Bingo caller for a game with 50 balls that announces clues, from an
+ *   embedded pack or a file.
  * @details The bingo caller's announcements are randomly selected from all the
  *   possible "clue" announcements for that value, as read from the clue file.
  */
@@ -153,15 +358,29 @@ class Bingo50Caller : public BingoCaller {
  public:
   /**
   * @brief Default constructor.
-  * @details Calls the other constructor with default value for
-  *   cluesFile of "data/bingo50calls.csv".
+  * @details Uses the embedded "bingo50calls" pack, the clues of
+  *   data/bingo50calls.csv, so no file is read.
   * @param [in] victory The victoryType for this game.
   */
   Bingo50Caller(BingoTypes::victoryType victory = BingoTypes::HORIZONTAL_LINE);
 
+  /**
+  * @brief Constructor, for clues that are already loaded.
+  * @details Use ClueTable::embedded to select a pack compiled into the
+  *   program by name, e.g. Bingo50Caller(ClueTable::embedded("bingo50clues",
+  *   Bingo50Spec::NUM_BALLS)), which does no I/O and no allocation for the
+  *   clues.
+  * @param [in] clues The clues, must have a line for each of the 50 values.
+  * @param [in] victory The victoryType for this game.
+  * @throw bad_input If clues does not have 50 values.
+  */
+  explicit Bingo50Caller(ClueTable clues,
+                         BingoTypes::victoryType victory =
+                           BingoTypes::HORIZONTAL_LINE);
+
   /**
   * @brief Constructor.
-  * @details Creates all the balls for this game and stores them in _ballCage.
+  * @details Creates all the balls for this game and puts them in the cage.
   *   Sets _description, and _game, calls readClues to populate _clues.
   * @param [in] clueFile The relative address of the clueFile.
   * @param [in] victory The victoryType for this game.
@@ -170,36 +389,38 @@ class Bingo50Caller : public BingoCaller {
                 BingoTypes::victoryType victory = BingoTypes::HORIZONTAL_LINE);
 
   /**
-  * @brief Destructor, deallocates the 2 dimensional dynamic array _clues.
+  * @brief Destructor.
   */
   virtual ~Bingo50Caller();
 
   /**
   * @brief Creates a message regarding the current ball.
   * @details The message is in the form "B : 4 + 6." There are four possible
-  * equations for each number stored in a file with the relative address
-  * data/bingo50calls.csv. This file contains 50 lines. Example line:
+  * equations for each number in the default pack, made from the file with
+  * the relative address data/bingo50calls.csv. Example line:
   * "10,B : 5 x 2,B : 20 / 2,B : 4 + 6,B: 15 - 5"
-  * @return The message to be displayed.
-  * @throw invalid_size if _ballsChosen is empty.
+  *   A game with its own stream picks the clue from its seed, game id and
+  *   the ball's ordinal alone, so announcing never moves the draw.
+  * @return The message to be displayed, a view of the clue table.
+  * @throw invalid_size if no balls have been pulled.
   */
-  std::string getAnnouncement();
+  std::string_view getAnnouncement();
 
   /**
-  * @brief Read the clues from the file into the _clues dynamic array.
+  * @brief Read the clues from the file into the _clues table.
   * @details The file must be comma delimited. The first line indicates the
   *   number of values for which clues are provided (must be 50) and
-  *   the second line indicates the number of clues for each value (must be
-  *   between 1 and 10). Each subsequent line contains a value, followed by
-  *   the indicated number of clues.
+  *   the number of clues for each value (must be between 1 and 10). Each
+  *   subsequent line contains a value, followed by the indicated number of
+  *   clues. See ClueTable::parse.
   * @param cluesFile The relative address of the file containing the clues.
-  * @throw bad_input If the input file cannot be open or the format is incorrect.
+  * @throw bad_input If the input file cannot be open or the format is
+  *   incorrect, the message gives the line and column of the problem.
   */
   void readClues(std::string cluesFile);
 
  private:
-  std::string** _clues;
-  unsigned _numClues;
+  ClueTable _clues;
 };
 
 /**
@@ -210,7 +431,7 @@ class Bingo75Caller : public BingoCaller {
  public:
   /**
   * @brief Default constructor.
-  * @details Creates all the balls for this game and stores them in _ballCage.
+  * @details Creates all the balls for this game and puts them in the cage.
   *   Sets _description, and _game.
   * @param [in] victory The victoryType for this game.
   */
@@ -223,10 +444,11 @@ class Bingo75Caller : public BingoCaller {
 
 
   /**
-  * @brief Constructs a string on the form X:##. is: O:72 or B:03.
-  * @return The message to be displayed.
-  * @throw invalid_size if _ballsChosen is empty or _currentBall is 0.
+  * @brief Announces the current ball in the form "Letter O, Number 72".
+  * @return The message to be displayed, a view of the announcement table
+  *   of Bingo75Spec.
+  * @throw invalid_size if no balls have been pulled.
   */
-  std::string getAnnouncement();
+  std::string_view getAnnouncement();
 };
 #endif // BINGOCALLER_H_INCLUDED
@@ -1,150 +1,247 @@
 #include <algorithm>
+#include <iterator>
 #include <string>
-#include <vector>
 
 #include "BingoTypes.h"
 #include "BingoCard.h"
 #include "UserInput.h"
 #include "VictoryCondition.h"
 #include "Square.h"
+#include "GameSpec.h"
+#include "WinPatterns.h"
 #include "Exceptions.h"
 
 BingoCard::BingoCard(BingoTypes::gameType game)
-    : _game{game} {
-    _victoryCondition = nullptr;
-}
+    : _grid{}, _game{game}, _victory{BingoTypes::HORIZONTAL_LINE},
+      _hasVictory{false}, _hasGrid{false}, _daubMask{0}, _errorMask{0},
+      _lineCount{} {}
 
-BingoCard::BingoCard(std::vector<Square*> grid, BingoTypes::gameType type)
+BingoCard::BingoCard(const gridType& grid, BingoTypes::gameType type)
     : BingoCard{type} {
     setGrid(grid);
 }
 
-BingoCard::~BingoCard() {
-    // Deallocate any dynamically allocated memory
-    for (auto square : _grid) {
-        delete square;
-    }
-}
-
 BingoTypes::gameType BingoCard::getGameType() {
     return _game;
 }
 
 BingoTypes::victoryType BingoCard::getVictoryType() {
-    // Check if victory condition is set and use its victory type
-    if (_victoryCondition) {
-        return _victoryCondition->getVictoryType();
-    } else {
-        // Default to blackout if no victory condition set
-        return BingoTypes::BLACKOUT;
-    }
+  checkVictoryIsSet();
+  return _victory;
 }
 
 Square* BingoCard::getSquare(BingoTypes::squarePos pos) {
-    // Validate position and access square from the grid
-    unsigned location = squarePosToLocation(pos);
-    if (location >= _grid.size()) {
-        throw bad_input("Invalid square position entered.");
-    }
-    return _grid[location];
+  return &_grid[squarePosToLocation(pos)];
 }
 
 void BingoCard::setVictoryCondition(VictoryCondition* victory) {
-    // Assign the victory condition
-    _victoryCondition = victory;
+  if (victory == nullptr) {
+    throw bad_input("The victory condition cannot be a nullptr.");
+  }
+  BingoTypes::victoryType type = victory->getVictoryType();
+  delete victory;
+  setVictoryType(type);
 }
 
-void BingoCard::setGrid(std::vector<Square*> grid) {
-  // Validate grid size
-  if (grid.size() != 25) {
-    throw bad_input("Invalid grid size. Bingo card requires 25 squares.");
-  }
-  if (!typesMatch(_game, grid)) {
-    throw bad_input("Grid squares do not match the specified game type.");
+void BingoCard::setVictoryType(BingoTypes::victoryType victory) {
+  if (!WinPatterns::isValid(victory)) {
+    throw bad_input("The victory type is not valid.");
   }
+  _victory = victory;
+  _hasVictory = true;
+}
 
+void BingoCard::setGrid(const gridType& grid) {
   checkGridValidity(grid);
 
-  for (auto square : _grid) {
-    delete square;
-  }
   _grid = grid;
+  _hasGrid = true;
+
+  _daubMask = 0;
+  _errorMask = 0;
+  std::fill(std::begin(_lineCount), std::end(_lineCount), 0);
+  for (unsigned i = 0; i < _grid.size(); ++i) {
+    updateMasks(i);
+  }
 }
 
 void BingoCard::resetCard() {
-    // Mark all squares as undaubed
-    for (auto square : _grid) {
-        square->setDaubed(false);
-        square->reset();
-    }
-
+  checkGridIsSet();
+
+  _daubMask = 0;
+  _errorMask = 0;
+  std::fill(std::begin(_lineCount), std::end(_lineCount), 0);
+  for (unsigned i = 0; i < _grid.size(); ++i) {
+    _grid[i].resetSquare();
+    updateMasks(i);
+  }
 }
 
 bool BingoCard::daubSquare(unsigned numberCalled, BingoTypes::squarePos pos) {
-  // Get the square at the specified position
-  Square* square = getSquare(pos);
-  // Check if the square matches the called number
-  if (square->matchesNumber(numberCalled)) {
-    square->daub(); // Mark the square as daubed
-    return true;
-  } else {
-    return false;
+  return daubSquare(numberCalled, squarePosToLocation(pos));
+}
+
+bool BingoCard::daubSquare(unsigned numberCalled, unsigned location) {
+  checkGridIsSet();
+  if (location >= WinPatterns::NUM_SQUARES) {
+    throw bad_input("Invalid square location.");
+  }
+
+  Square& square = _grid[location];
+  bool daubed = square.daubSquare(numberCalled);
+  updateMasks(location);
+
+  if (square.getValue() != numberCalled) {
+    for (unsigned i = 0; i < _grid.size(); ++i) {
+      _grid[i].shouldDaubSquare(numberCalled);
+      updateMasks(i);
+    }
   }
+
+  return daubed;
 }
 
 bool BingoCard::isCorrect() {
-    // Check if all squares are correctly marked
-    for (auto square : _grid) {
-        if (!square->isCorrect()) {
-            return false;
-        }
-    }
-    return true;
+  checkGridIsSet();
+  return _errorMask == 0;
 }
 
 bool BingoCard::isVictorious() {
-    // Check if the victory condition is met
-    if (_victoryCondition) {
-        return _victoryCondition->checkVictory(_grid);
-    } else {
-        // Check for blackout if no victory condition set
-        for (auto square : _grid) {
-            if (!square->isDaubed()) {
-                return false;
-            }
-        }
-        return true;
-    }
+  checkGridIsSet();
+  checkVictoryIsSet();
+  return WinPatterns::hasWon(_victory, getDaubMask());
+}
+
+bool BingoCard::isVictorious(const BingoTypes::ballMask& called) {
+  checkGridIsSet();
+  checkVictoryIsSet();
+  unsigned daubs = getDaubMask() & getCalledSquares(called);
+  return WinPatterns::hasWon(_victory, daubs);
+}
+
+unsigned BingoCard::getCalledSquares(const BingoTypes::ballMask& called) {
+  unsigned squares = 0;
+  for (unsigned i = 0; i < _grid.size(); ++i) {
+    unsigned value = _grid[i].getValue();
+    unsigned isCalled = (called[value / 64] >> (value % 64)) & 1;
+    squares |= (isCalled | _grid[i].isFree()) << i;
+  }
+  return squares;
+}
+
+bool BingoCard::completesVictory(unsigned location) {
+  checkVictoryIsSet();
+  if (location >= WinPatterns::NUM_SQUARES) {
+    return false;
+  }
+
+  const WinPatterns::PatternSet& set = WinPatterns::patterns(_victory);
+  unsigned lines = WinPatterns::LINES_OF[location];
+  for (unsigned m = set.first; m < set.first + set.count; ++m) {
+    if ((lines & (1u << m)) && _lineCount[m] == WinPatterns::MASK_SIZES[m])
+      return true;
+  }
+  return false;
 }
 
 bool BingoCard::typesMatch(BingoTypes::gameType game,
                            BingoTypes::victoryType victory) {
-  // Check if square types match the game type and victory condition
-  switch (game) {
-    case BingoTypes::BINGO50:
-      // Only BINGO50Square allowed
-      return (victory == BingoTypes::BLACKOUT ||
-              dynamic_cast<Bingo50Square*>(getSquare({1, 1})) != nullptr);
-    case BingoTypes::BINGO75:
-      // Bingo75Square or FreeSquare allowed
-      return true;
-    default:
-      throw bad_input("Invalid game type.");
+  return game == _game && victory == getVictoryType();
+}
+
+bool BingoCard::isValidFor(BingoTypes::gameType game) const {
+  const GameInfo* info = GameInfo::forGame(game);
+  if (info == nullptr || _game != game || !_hasGrid || !_hasVictory
+      || !WinPatterns::isValid(_victory)) {
+    return false;
+  }
+  for (unsigned i = 0; i < _grid.size(); ++i) {
+    if (_grid[i].isFree() != (i == WinPatterns::FREE_LOCATION)
+        || _grid[i].getState() > Square::NEEDS_DAUB) {
+      return false;
+    }
+    unsigned value = _grid[i].getValue();
+    unsigned col = WinPatterns::column(i);
+    if (!_grid[i].isFree()
+        && (value < info->colMin(col) || value > info->colMax(col))) {
+      return false;
+    }
   }
+  return true;
 }
 
-void BingoCard::checkGridValidity(std::vector<Square*> grid) {
-    // Check if the grid size and square types are valid for the game type
-    if (grid.size() != 25) {
-        throw bad_input("Invalid grid size. Expected 25 squares.");
+void BingoCard::checkGridValidity(const gridType& grid) {
+  const GameInfo* info = GameInfo::forGame(_game);
+  if (info == nullptr) {
+    throw card_to_game_mismatch("The card's game type is not valid.");
+  }
+  unsigned values[WinPatterns::NUM_SQUARES];
+  unsigned numValues = 0;
+
+  for (unsigned i = 0; i < grid.size(); ++i) {
+    if (grid[i].isFree() != (i == WinPatterns::FREE_LOCATION)) {
+      throw card_to_game_mismatch
+      ("Only the center square of a bingo card can be free.");
     }
-    // Add additional checks based on specific game rules and square types
+    if (grid[i].isFree()) {
+      continue;
+    }
+    unsigned value = grid[i].getValue();
+    unsigned col = WinPatterns::column(i);
+    if (value < info->colMin(col) || value > info->colMax(col)) {
+      throw card_to_game_mismatch
+      ("A square's value is not valid for its column in this game type.");
+    }
+    values[numValues++] = value;
+  }
+
+  std::sort(values, values + numValues);
+  if (std::adjacent_find(values, values + numValues) != values + numValues) {
+    throw bad_input("The values of the squares must be unique.");
+  }
 }
 
 unsigned BingoCard::squarePosToLocation(BingoTypes::squarePos pos) {
-    if (pos.row < 1 || pos.row > 5 || pos.col < 1 || pos.col > 5) {
+    if (pos.row < 1 || pos.row > WinPatterns::NUM_ROWS ||
+        pos.col < 1 || pos.col > WinPatterns::NUM_COLS) {
         throw bad_input("Invalid square position entered.");
     }
 
-    return (5 * (pos.col - 1) + (pos.row - 1));
+    return WinPatterns::location(pos.row - 1, pos.col - 1);
+}
+
+void BingoCard::checkGridIsSet() {
+  if (!_hasGrid) {
+    throw incomplete_settings("The bingo card's grid has not been set.");
+  }
+}
+
+void BingoCard::checkVictoryIsSet() {
+  if (!_hasVictory) {
+    throw incomplete_settings("The victory condition has not been set.");
+  }
+}
+
+void BingoCard::updateMasks(unsigned location) {
+  Square::daubState state = _grid[location].getState();
+  unsigned bit = 1u << location;
+  bool wasCounted = getDaubMask() & bit;
+
+  if (state == Square::GOOD_DAUB || state == Square::BAD_DAUB)
+    _daubMask |= bit;
+  else
+    _daubMask &= ~bit;
+
+  if (state == Square::NO_DAUB || state == Square::GOOD_DAUB)
+    _errorMask &= ~bit;
+  else
+    _errorMask |= bit;
+
+  bool isCounted = getDaubMask() & bit;
+  if (isCounted != wasCounted) {
+    for (unsigned m = 0; m < WinPatterns::NUM_MASKS; ++m) {
+      if (WinPatterns::LINES_OF[location] & (1u << m))
+        _lineCount[m] += isCounted ? 1 : -1;
+    }
+  }
 }
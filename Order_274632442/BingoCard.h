@@ -2,43 +2,45 @@
 #ifndef BINGOCARD_H_INCLUDED
 #define BINGOCARD_H_INCLUDED
 
-#include <vector>
+#include <array>
+#include <type_traits>
 
 #include "UserInput.h"
 #include "VictoryCondition.h"
 #include "Square.h"
 #include "BingoTypes.h"
+#include "WinPatterns.h"
 
 /**
 * @class BingoCard BingoCard.h "BingoCard.h"
 * @brief Implements the bingo card for a game of bingo.
+* @details The squares are stored inline and the victory condition is kept
+*   as its victoryType, so a card owns no other memory. Cards are trivially
+*   copyable: they can be stored by value in containers and copied with
+*   memcpy.
 */
 class BingoCard {
  public:
+  /**< The squares of a card, stored at their WinPatterns::location. >**/
+  typedef std::array<Square, WinPatterns::NUM_SQUARES> gridType;
+
   /**
   * @brief Default constructor.
-  * @details Initializes _victoryCondition to nullptr.
+  * @details The victory condition and grid are not set.
   * @param [in] type The type of game that can use this bingo card.
   */
   BingoCard(BingoTypes::gameType type = BingoTypes::BINGO75);
 
   /**
   * @brief Constructor, uses setGrid.
-  * @details Initializes _victoryCondition to nullptr, and uses setGrid to
+  * @details The victory condition is not set, uses setGrid to
   *   initialize the squares in _grid.
   * @param [in] grid The squares on the bingo card.
   * @param [in] type The type of game that can use this bingo card.
   */
-  BingoCard(std::vector<Square*> grid,
+  BingoCard(const gridType& grid,
             BingoTypes::gameType type = BingoTypes::BINGO75);
 
-  /**
-  * @brief Destructor.
-  * @details Deallocates _victoryCondition and all the Square pointers
-  *   in _grid.
-  */
-  virtual ~BingoCard();
-
   /**
   * @brief Access the gameType of this card.
   * @return The gameType set for this card.
@@ -48,42 +50,50 @@ class BingoCard {
   /**
   * @brief Access the victoryType of this card.
   * @return The victoryType set for this card.
-  * @throw incomplete_settings If _victoryCondition is a nullptr.
+  * @throw incomplete_settings If the victory condition is not set.
   */
   BingoTypes::victoryType getVictoryType();
 
   /**
   * @brief Gives access to the square in the given position.
   * @param pos The position of the desired square.
-  * @return A pointer to the desire square.
+  * @return A pointer to the desire square, it stays owned by the card.
   */
   Square* getSquare(BingoTypes::squarePos pos);
 
   /**
-  * @brief Updates the _victoryCondition.
+  * @brief Updates the victory condition.
+  * @details The card keeps the victory type and deletes victory.
   * @param victory A pointer to an instance of a VictoryCondition.
   * @throw bad_input If victory is a nullptr.
   */
   void setVictoryCondition(VictoryCondition* victory);
 
+  /**
+  * @brief Updates the victory condition.
+  * @param victory A victory type in the WinPatterns table.
+  * @throw bad_input If victory is not a valid victory type.
+  */
+  void setVictoryType(BingoTypes::victoryType victory);
+
   /**
   * @brief If grid defines a valid bingo card for this gameType, sets _grid.
   * @details Uses checkGridValidity to make sure grid defines a valid bingo card.
   * @param [in] grid The Squares that define a bingo card.
   */
-  void setGrid(std::vector<Square*> grid);
+  void setGrid(const gridType& grid);
 
   /**
    * @brief Resets all the squares in the bingo card.
-   * @details Uses checkGridValidity to make sure the grid has been set before attempting to reset squares.
+   * @details Uses checkGridIsSet to make sure the grid has been set before attempting to reset squares.
   */
   void resetCard();
 
   /**
   * @brief Attempts to daub the indicated Square, returns false if already daubed.
-  * @details Uses checkGridValidity to make sure the grid is set properly.
-  *   Uses squarePosToLoc to access the correct access the correct Square pointer.
-  *   The Square pointer is used to call daubSquare.
+  * @details Uses checkGridIsSet to make sure the grid is set properly.
+  *   Uses squarePosToLoc to access the correct Square, which is used to
+  *   call daubSquare.
   *   If the numberCalled doesn't equal the square's value then shouldDaubSquare is
   *   called with every square in the grid.
   * @param [in] numberCalled The number called by the bingo caller.
@@ -92,21 +102,98 @@ class BingoCard {
   */
   bool daubSquare(unsigned numberCalled, BingoTypes::squarePos pos);
 
+  /**
+  * @brief Attempts to daub the Square at a location in the grid.
+  * @details Same as daubSquare(unsigned, squarePos) for callers that already
+  *   know the location, like the NumberIndex postings.
+  * @param [in] numberCalled The number called by the bingo caller.
+  * @param [in] location The location of the square, see WinPatterns::location.
+  * @return false, if the square at location is already daubed and true
+  *   otherwise.
+  * @throw bad_input if location is not less than WinPatterns::NUM_SQUARES.
+  */
+  bool daubSquare(unsigned numberCalled, unsigned location);
+
   /**
    * @brief Determines if the player has made any errors daubing this card.
-   * @details Uses checkGridValidity to make sure the grid is set correctly.
+   * @details Uses checkGridIsSet to make sure the grid is set correctly.
+   *   Answered from the error mask without visiting the squares.
   * @return false, if an error is found, true otherwise.
   */
   bool isCorrect();
 
   /**
    * @brief Determines if the card has correctly met the victory conditions.
-   * @details Uses checkGridValidity to make sure the grid is set properly.
+   * @details Uses checkGridIsSet to make sure the grid is set properly.
+   *   The correctly daubed squares (_daubMask without _errorMask) are
+   *   passed to the victory condition as a single mask.
   * @return true, if the card has met the victory condition, false otherwise.
-  * @throw incomplete_settings If _victoryCondition is a nullptr.
+  * @throw incomplete_settings If the victory condition is not set.
   */
   bool isVictorious();
 
+  /**
+  * @brief Determines if the card has met the victory conditions using only
+  *   squares whose numbers were called.
+  * @details Verifies a bingo claim against the caller, a daubed square
+  *   counts only if its number is in called.
+  * @param [in] called The called ball mask, see BingoCaller::calledMask.
+  * @return true, if the card has met the victory condition, false otherwise.
+  * @throw incomplete_settings If the victory condition is not set.
+  */
+  bool isVictorious(const BingoTypes::ballMask& called);
+
+  /**
+  * @brief Access the squares whose numbers were called.
+  * @details One bit test per square, the free square is always included.
+  * @param [in] called The called ball mask, see BingoCaller::calledMask.
+  * @return A mask with bit WinPatterns::location(row, col) set for each
+  *   square whose number was called.
+  */
+  unsigned getCalledSquares(const BingoTypes::ballMask& called);
+
+  /**
+  * @brief Determines if a line through the square at location, that meets
+  *   this card's victory condition, is now correctly daubed.
+  * @details Answered in constant time from the per line counters, so the
+  *   game can flag a winner as soon as the winning square is daubed.
+  * @param [in] location The location of the square that was daubed.
+  * @return true, if a winning line holds location and is complete.
+  * @throw incomplete_settings If the victory condition is not set.
+  */
+  bool completesVictory(unsigned location);
+
+  /**
+  * @brief Access the squares that are daubed and correct.
+  * @details Bit WinPatterns::location(row, col) is set for each such square,
+  *   this is the mask the victory conditions and CardBatch are checked with.
+  * @return The correct daub mask of this card.
+  */
+  unsigned getDaubMask() {
+    return _daubMask & ~_errorMask;
+  }
+
+  /**
+  * @brief Access the value of the square at a location in the grid.
+  * @param [in] location The location of the square, less than
+  *   WinPatterns::NUM_SQUARES.
+  * @return The square's value, 0 for the free square.
+  */
+  unsigned getValue(unsigned location) const {
+    return _grid[location].getValue();
+  }
+
+  /**
+  * @brief Determines if the card's bytes hold a set card of a game.
+  * @details For a card that was not built by its constructors, like one
+  *   read in place from a snapshot. The grid and a victory type in the
+  *   WinPatterns table must be set, only the center square can be free
+  *   and every other value must be in its column's range for game.
+  * @param [in] game The game type the card must have.
+  * @return true if the card can be used in game, false otherwise.
+  */
+  bool isValidFor(BingoTypes::gameType game) const;
+
   /**
   * @brief Determines if the given types and the card's types are equal.
   * @param [in] game The game type compared to the card's gameType.
@@ -117,22 +204,50 @@ class BingoCard {
   bool typesMatch(BingoTypes::gameType game, BingoTypes::victoryType victory);
 
  private:
-  VictoryCondition* _victoryCondition;
-  std::vector<Square*> _grid;
+  gridType _grid;
   BingoTypes::gameType _game;
+  BingoTypes::victoryType _victory;
+  bool _hasVictory;
+  bool _hasGrid;
+  unsigned _daubMask;
+  unsigned _errorMask;
+  /**< Correctly daubed squares in each of WinPatterns::MASKS. >**/
+  unsigned char _lineCount[WinPatterns::NUM_MASKS];
+
+  /**
+  * @brief Copies the daub state of the square at location into the masks.
+  * @details Bit location of _daubMask is set if the square is daubed and
+  *   bit location of _errorMask is set if the square is not correct.
+  *   When the square becomes, or stops being, correctly daubed the
+  *   counters of the lines holding it are updated.
+  * @param [in] location The location of the square in _grid.
+  */
+  void updateMasks(unsigned location);
+
+  /**
+  * @brief Cheap check used by the per-call methods, the grid's contents were
+  *   already validated by setGrid.
+  * @throw incomplete_settings if the grid has not been set.
+  */
+  void checkGridIsSet();
+
+  /**
+  * @brief Used by the methods that need the victory condition.
+  * @throw incomplete_settings If the victory condition is not set.
+  */
+  void checkVictoryIsSet();
 
   /**
   * @brief Determines if the numbers on the card are valid.
   * @details Checks that all numbers on the bingo card are distinct.
   *   Checks that the numbers under the B are in the first fifth of the number
   *   range, that those under I are in the second fifth of the number range, and so on.
-  * @throw incomplete_settings if there are no squares in the grid.
-  * @throw invalid_size if the grid's size is not 25.
+  *   Exactly the square at WinPatterns::FREE_LOCATION must be free.
   * @throw card_to_game_mismatch if the value of a square is not correct for its
   * position in the grid for the gameType of this card.
   * @throw bad_input If all the values in the squares are not unique.
   */
-  void checkGridValidity(std::vector<Square*> grid);
+  void checkGridValidity(const gridType& grid);
 
   /**
    * @brief Convert a position entered by the user to a location in _grid.
@@ -143,4 +258,7 @@ class BingoCard {
   unsigned squarePosToLocation(BingoTypes::squarePos pos);
 };
 
+static_assert(std::is_trivially_copyable<BingoCard>::value,
+              "Cards are stored by value and copied with memcpy");
+
 #endif // BINGOCARD_H_INCLUDED
@@ -1,11 +1,15 @@
 
+#include <algorithm>
 #include <vector>
 
 #include "BingoCard.h"
 #include "BingoCardFactory.h"
 #include "BingoTypes.h"
+#include "CardArena.h"
+#include "GameSpec.h"
 #include "MakeRandomInt.h"
 #include "VictoryCondition.h"
+#include "WinPatterns.h"
 #include "Exceptions.h"
 
 BingoCardFactory::BingoCardFactory() {}
@@ -13,44 +17,56 @@ BingoCardFactory::BingoCardFactory() {}
 BingoCardFactory::~BingoCardFactory() {}
 
 BingoCard* BingoCardFactory::makeBingoCard(BingoTypes::gameType game,
-    VictoryCondition* victory) {
+    VictoryCondition* victory, CardArena* arena) {
+  return makeCard(game, victory, arena, MakeRandomInt::getInstance());
+}
+
+BingoCard* BingoCardFactory::makeBingoCard(BingoTypes::gameType game,
+    VictoryCondition* victory, std::uint64_t seed, std::uint64_t cardId,
+    CardArena* arena) {
+  MakeRandomInt random(seed, cardId);
+  return makeCard(game, victory, arena, random);
+}
+
+BingoCard* BingoCardFactory::makeCard(BingoTypes::gameType game,
+    VictoryCondition* victory, CardArena* arena, MakeRandomInt& random) {
   if (victory == nullptr) {
     throw incomplete_settings
     ("Factory cannot make Bingo Card without a victory condition.");
   }
-  if (game != BingoTypes::BINGO50 && game != BingoTypes::BINGO75) {
+  const GameInfo* info = GameInfo::forGame(game);
+  if (info == nullptr) {
     throw invalid_size("The game must be a valid gameType.");
   }
 
-  BingoCard* card = new BingoCard(game);
-  card->setVictoryCondition(copyVictoryCondition(victory));
-
-  delete victory;
-
-  unsigned cardMax = static_cast<unsigned>(game);
-  unsigned colRange = cardMax / 5;
-
-  std::vector<Square*> grid;
-  std::vector<Square*> newSquares;
-
-  for (int i = 0; i < 5; ++i) {
-    newSquares = makeSquares(i * colRange + 1, (i + 1) * colRange);
-    grid.insert(grid.end(), newSquares.begin(), newSquares.end());
-    newSquares.erase(newSquares.begin(), newSquares.end());
+  if (!WinPatterns::isValid(victory->getVictoryType())) {
+    throw incomplete_settings
+    ("Factory cannot make Bingo Card without a valid victory condition.");
   }
 
-  if (grid.size() > 12) {
-    delete grid[12];
-    grid[12] = new FreeSquare();
+  BingoCard::gridType grid;
+  for (unsigned i = 0; i < WinPatterns::NUM_COLS; ++i) {
+    std::vector<Square> column =
+      makeSquares(info->colMin(i), info->colMax(i), WinPatterns::NUM_ROWS,
+                  random);
+    std::copy(column.begin(), column.end(),
+              grid.begin() + WinPatterns::location(0, i));
   }
+  grid[WinPatterns::FREE_LOCATION] = FreeSquare();
 
-  card->setGrid(grid);
+  BingoCard* card;
+  if (arena != nullptr) {
+    card = arena->make<BingoCard>(grid, game);
+  } else {
+    card = new BingoCard(grid, game);
+  }
+  card->setVictoryType(victory->getVictoryType());
 
   return card;
 }
 
-std::vector<Square*> BingoCardFactory::makeSquares(unsigned min, unsigned max,
-    unsigned n) {
+std::vector<Square> BingoCardFactory::makeSquares(unsigned min, unsigned max,
+    unsigned n, MakeRandomInt& random) {
   if (max - min + 1 < n) {
     throw invalid_size("Insufficient range to make distinct squares.");
   }
@@ -60,30 +76,12 @@ std::vector<Square*> BingoCardFactory::makeSquares(unsigned min, unsigned max,
     range.push_back(i);
   }
 
-  MakeRandomInt& randInt = MakeRandomInt::getInstance();
-
-  std::vector<Square*> squares;
+  std::vector<Square> squares;
   for (unsigned k = 0; k < n; ++k) {
-    unsigned nextPos = randInt.getValue(range.size());
-    squares.push_back(new IntSquare(range[nextPos]));
-    range.erase(range.begin() + nextPos);
+    unsigned nextPos = k + random.getValue(range.size() - k);
+    squares.push_back(IntSquare(range[nextPos]));
+    range[nextPos] = range[k];
   }
 
   return squares;
 }
-
-VictoryCondition* BingoCardFactory::copyVictoryCondition
-(VictoryCondition* victory) {
-  switch (victory->getVictoryType()) {
-    case BingoTypes::ANY_LINE:
-      return new AnyLine();
-    case BingoTypes::HORIZONTAL_LINE:
-      return new HorizontalLine();
-    case BingoTypes::VERTICAL_LINE:
-      return new VerticalLine();
-    case BingoTypes::BLACKOUT:
-      return new Blackout();
-    default:
-      return nullptr;
-  }
-}
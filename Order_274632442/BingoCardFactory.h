@@ -2,10 +2,13 @@
 #ifndef BINGO_CARD_FACTORY_H_INCLUDED
 #define BINGO_CARD_FACTORY_H_INCLUDED
 
+#include <cstdint>
 #include <vector>
 
 #include "BingoCard.h"
 #include "BingoTypes.h"
+#include "CardArena.h"
+#include "MakeRandomInt.h"
 #include "VictoryCondition.h"
 
 /**
@@ -25,34 +28,67 @@ class BingoCardFactory {
   virtual ~BingoCardFactory();
 
   /**
-   * @brief Create a BingoCard, uses copyVictoryCondition.
+   * @brief Create a BingoCard.
+   * @details If an arena is given, the card, which holds its squares and
+   *   victory type inline, is constructed in it. The caller keeps
+   *   ownership of victory.
    * @param [in] game The gameType desired.
    * @param [in] victory A pointer to a victory condition.
+   * @param [in] arena The arena to make the card in, or nullptr to use new.
    * @return A pointer to a BingoCard for the given game type with the given
    *   victory condition.
-   * @throw incomplete_settings If victory is a nullptr
+   * @throw incomplete_settings If victory is a nullptr or its victory type
+   *   is not in the WinPatterns table.
    * @throw invalid_size If game isn't a valid gameType.
    */
   BingoCard* makeBingoCard(BingoTypes::gameType game,
-                           VictoryCondition* victory);
+                           VictoryCondition* victory,
+                           CardArena* arena = nullptr);
+
+  /**
+   * @brief Create the BingoCard numbered cardId of a seeded set of cards.
+   * @details The numbers are drawn from the counter based stream (seed,
+   *   cardId), so a card can be made again from its seed and id alone, on
+   *   any thread and in any order.
+   * @param [in] game The gameType desired.
+   * @param [in] victory A pointer to a victory condition.
+   * @param [in] seed The seed of the set of cards.
+   * @param [in] cardId The id of the card in the set.
+   * @param [in] arena The arena to make the card in, or nullptr to use new.
+   * @return A pointer to a BingoCard for the given game type with the given
+   *   victory condition.
+   * @throw incomplete_settings If victory is a nullptr or its victory type
+   *   is not in the WinPatterns table.
+   * @throw invalid_size If game isn't a valid gameType.
+   */
+  BingoCard* makeBingoCard(BingoTypes::gameType game,
+                           VictoryCondition* victory,
+                           std::uint64_t seed, std::uint64_t cardId,
+                           CardArena* arena = nullptr);
 
  private:
+  /**
+   * @brief Create a BingoCard with numbers drawn from random.
+   * @param [in] game The gameType desired.
+   * @param [in] victory A pointer to a victory condition.
+   * @param [in] arena The arena to make the card in, or nullptr to use new.
+   * @param [in] random The random values to draw the numbers from.
+   * @return A pointer to the new BingoCard.
+   */
+  BingoCard* makeCard(BingoTypes::gameType game, VictoryCondition* victory,
+                      CardArena* arena, MakeRandomInt& random);
+
   /**
    * @brief Make n distinct squares with values in a [min, max].
    * @param [in] max The maximum value for a Square.
    * @param [in] min The minimum value for a Square.
-   * @param [in] n the number of Squares desired, default value is 5.
-   * @return A vector of Square pointers with n distinct values.
+   * @param [in] n the number of Squares desired.
+   * @param [in] random The random values to pick the squares with.
+   * @return A vector of n Squares with distinct values.
    * @throw invalid_size if can't make n distinct values in the desired range.
    */
-  std::vector<Square*> makeSquares(unsigned min, unsigned max, unsigned n = 5);
-
-  /**
-   * @brief Copy a VictoryCondition.
-   * @param [in] victory A victory condition pointer.
-   * @return A victory condition pointer.
-   */
-  VictoryCondition* copyVictoryCondition(VictoryCondition* victory);
+  std::vector<Square> makeSquares(unsigned min, unsigned max, unsigned n,
+                                  MakeRandomInt& random);
 };
 
 #endif // BINGO_CARD_FACTORY_H_INCLUDED
@@ -1,24 +1,160 @@
 
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
 #include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "BingoGame.h"
 #include "BingoTypes.h"
+#include "CardBatch.h"
+#include "MappedFile.h"
 #include "ScreenDisplay.h"
+#include "Square.h"
 #include "UserInput.h"
 #include "VictoryCondition.h"
+#include "WinPatterns.h"
 
 #include "Exceptions.h"
 
+namespace {
+
+const char SNAPSHOT_MAGIC[8] = {'B', 'I', 'N', 'G', 'O', 'S', 'N', 'P'};
+const std::uint32_t SNAPSHOT_VERSION = 1;
+
+/**
+ * @brief The start of a snapshot file, followed by the sections of
+ *   snapshotLayout.
+ */
+struct snapshotHeader {
+  char magic[8];
+  std::uint32_t version;
+  /**< The sizes of the header and of a card in the build that saved it. >**/
+  std::uint32_t headerSize;
+  std::uint32_t cardSize;
+  std::uint32_t autoDaub;
+  std::uint32_t numSlots;
+  std::uint32_t numFree;
+  std::uint32_t numWinners;
+  std::uint32_t numBalls;
+  std::uint64_t numPostings;
+  std::uint64_t numEntries;
+  std::uint64_t idBytes;
+  std::uint64_t handleIdBytes;
+  BingoCaller::callerState caller;
+};
+
+/**
+ * @brief The offsets of the sections of a snapshot, each aligned for its
+ *   type so the sections of a mapped file can be read in place.
+ */
+struct snapshotLayout {
+  /**< BingoCard[numSlots], zeros for a free slot. >**/
+  std::size_t cards;
+  /**< uint32_t[numSlots], the end of each id in ids, free slots have an
+   empty id. >**/
+  std::size_t idEnds;
+  /**< uint32_t[numFree], the free slots in the order they are reused. >**/
+  std::size_t freeSlots;
+  /**< uint32_t[numWinners], the claims not yet answered. >**/
+  std::size_t winners;
+  /**< uint32_t[numBalls], the number of postings of each ball. >**/
+  std::size_t counts;
+  /**< NumberIndex::posting[numPostings], ball by ball. >**/
+  std::size_t postings;
+  /**< FlatIdMap::entry[numEntries], the table of handles by id. >**/
+  std::size_t entries;
+  /**< char[idBytes], the ids of the slots one after the other. >**/
+  std::size_t ids;
+  /**< char[handleIdBytes], the ids of the table's entries. >**/
+  std::size_t handleIds;
+  std::size_t size;
+
+  explicit snapshotLayout(const snapshotHeader& header) {
+    cards = alignUp(sizeof(snapshotHeader), alignof(BingoCard));
+    idEnds = alignUp(cards + std::size_t{header.numSlots} * sizeof(BingoCard),
+                     alignof(std::uint32_t));
+    freeSlots = idEnds + std::size_t{header.numSlots} * 4;
+    winners = freeSlots + std::size_t{header.numFree} * 4;
+    counts = winners + std::size_t{header.numWinners} * 4;
+    postings = alignUp(counts + std::size_t{header.numBalls} * 4,
+                       alignof(NumberIndex::posting));
+    entries = alignUp(postings
+                      + header.numPostings * sizeof(NumberIndex::posting),
+                      alignof(FlatIdMap::entry));
+    ids = entries + header.numEntries * sizeof(FlatIdMap::entry);
+    handleIds = ids + header.idBytes;
+    size = handleIds + header.handleIdBytes;
+  }
+
+  static std::size_t alignUp(std::size_t offset, std::size_t alignment) {
+    return (offset + alignment - 1) / alignment * alignment;
+  }
+};
+
+static_assert(std::is_trivially_copyable<snapshotHeader>::value,
+              "the header is saved and loaded with memcpy");
+static_assert(std::is_trivially_copyable<FlatIdMap::entry>::value,
+              "the handle table is saved and loaded with memcpy");
+static_assert(sizeof(BingoGame::playerHandle) == sizeof(std::uint32_t),
+              "handles are saved as uint32_t");
+
+/**
+ * @brief Write a file with one write, through a temporary file that is
+ *   synced and renamed over it.
+ * @param [in] fileName The name of the file.
+ * @param [in] data The contents.
+ * @param [in] size The number of bytes.
+ * @throw bad_input If the file can't be written.
+ */
+void writeWholeFile(const std::string& fileName, const char* data,
+                    std::size_t size) {
+  std::string tmpName = fileName + ".tmp";
+  int fd = ::open(tmpName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  bool ok = fd >= 0;
+  while (ok && size > 0) {
+    ssize_t written = ::write(fd, data, size);
+    ok = written > 0;
+    if (ok) {
+      data += written;
+      size -= static_cast<std::size_t>(written);
+    }
+  }
+  ok = ok && ::fsync(fd) == 0;
+  if (fd >= 0) {
+    ok = ::close(fd) == 0 && ok;
+  }
+  ok = ok && std::rename(tmpName.c_str(), fileName.c_str()) == 0;
+  if (!ok) {
+    std::remove(tmpName.c_str());
+    throw bad_input(("Could not write the snapshot file " + fileName +
+                     ".").c_str());
+  }
+}
+
+}  // namespace
+
 BingoGame::BingoGame() {
   _caller = nullptr;
+  _autoDaub = true;
+  _journal = nullptr;
 }
 
 BingoGame::~BingoGame() {
-    for (auto& player : _player) {
-        delete player.second;
-    }
-    _player.clear();
+  for (playerSlot& slot : _slots) {
+    destroyCard(slot.card);
+  }
+  _slots.clear();
 }
 
 BingoTypes::gameType BingoGame::getGameType() {
@@ -37,8 +173,12 @@ BingoTypes::victoryType BingoGame::getVictoryType() {
   return _caller->getVictoryType();
 }
 
+CardArena* BingoGame::getCardArena() {
+  return &_arena;
+}
+
 unsigned BingoGame::getNumPlayers() {
-  return _player.size();
+  return _handles.size();
 }
 
 void BingoGame::setCaller(BingoCaller* caller) {
@@ -47,6 +187,7 @@ void BingoGame::setCaller(BingoCaller* caller) {
   }
 
   _caller = caller;
+  _index.reset(_caller->getNumBalls());
 }
 
 void BingoGame::resetVictoryType(BingoTypes::victoryType victory) {
@@ -61,34 +202,74 @@ void BingoGame::resetVictoryType(BingoTypes::victoryType victory) {
   }
 
   _caller->setVictoryType(victory);
+  if (_journal != nullptr) {
+    _journal->gameSettings(victory, _autoDaub);
+  }
 }
 
 
+bool BingoGame::getAutoDaub() {
+  return _autoDaub;
+}
+
+void BingoGame::setAutoDaub(bool autoDaub) {
+  if (_caller != nullptr && _caller->getNumBallsPulled() > 0) {
+    throw function_unavailable
+    ("Auto daub cannot be changed after the game has begun.");
+  }
+  _autoDaub = autoDaub;
+  if (_journal != nullptr && _caller != nullptr) {
+    _journal->gameSettings(_caller->getVictoryType(), _autoDaub);
+  }
+}
+
+void BingoGame::setJournal(GameJournal* journal) {
+  _journal = journal;
+  if (_journal != nullptr && _caller != nullptr) {
+    _journal->gameSettings(_caller->getVictoryType(), _autoDaub);
+  }
+}
+
 void BingoGame::completeNextCall(std::ostream& out) {
-    if (_caller == nullptr) {
-        throw incomplete_settings("The caller hasn't been set.");
-    }
+  if (_caller == nullptr) {
+    throw incomplete_settings("The caller hasn't been set.");
+  }
 
-    if (_player.empty()) {
-        throw invalid_size("There are no players before the first turn.");
-    }
+  if (_handles.size() == 0) {
+    throw invalid_size("There are no players before the first turn.");
+  }
 
-    bool bingoCalled = false;
-    for (auto& player : _player) {
-        out << "Player: " << player.first << std::endl;
-        _caller->pullBall();
-        out << "Announcement: " << _caller->getAnnouncement() << std::endl;
-        player.second->daubNumber(_caller->getCurrentNumber());
+  callNext(out);
+  if (_journal != nullptr) {
+    _journal->commit();
+  }
+}
 
-        if (player.second->isWinner()) {
-            _winners.push_back(player.first);
-            bingoCalled = true;
-        }
-    }
+void BingoGame::callNext(std::ostream& out) {
+  if (!_winners.empty()) {
+    endGame(out);
+    return;
+  }
 
-    if (bingoCalled || _player.size() == 0) {
-        endGame(out);
-    }
+  ScreenDisplay screen;
+  if (!_caller->pullBall()) {
+    screen.displayCallerMessage(out, "All the balls have been called.\n");
+    endGame(out);
+    return;
+  }
+  if (_journal != nullptr) {
+    _journal->ballPulled(_caller->getCurrentNumber(), _autoDaub);
+  }
+  std::string msg(_caller->getAnnouncement());
+  screen.displayCallerMessage(out, msg + "\n");
+
+  if (_autoDaub) {
+    daubCalledNumber(_caller->getCurrentNumber());
+  }
+
+  if (!_winners.empty()) {
+    endGame(out);
+  }
 }
 
 void BingoGame::takeAction(std::ostream& out, std::istream& in, std::string id,
@@ -98,90 +279,197 @@ void BingoGame::takeAction(std::ostream& out, std::istream& in, std::string id,
     ("Bingo caller is not set, cannot start the game.");
   }
 
-  if (_player.empty()) {
+  if (_handles.size() == 0) {
     throw incomplete_settings
     ("No players added, cannot start the game.");
   }
 
-  if (_player.find(id) == _player.end()) {
+  playerHandle player = _handles.find(id);
+  if (player == NO_PLAYER) {
     throw invalid_identifier("Unknown identifier.");
   }
 
+  takeAction(out, in, player, move);
+}
+
+void BingoGame::takeAction(std::ostream& out, std::istream& in,
+                           playerHandle player, BingoTypes::moveType move) {
+  if (_caller == nullptr) {
+    throw incomplete_settings
+    ("Bingo caller is not set, cannot start the game.");
+  }
+
+  if (_handles.size() == 0) {
+    throw incomplete_settings
+    ("No players added, cannot start the game.");
+  }
+
+  cardOf(player);
+
   switch (move) {
     case BingoTypes::DAUB :
-      daubMove(out, in, id);
+      daubMove(out, in, player);
       break;
     case BingoTypes::BINGO :
-      bingoMove(out, in, id);
+      bingoMove(out, in, player);
       break;
     case BingoTypes::SHOW_CARD :
-      showCardMove(out, in, id);
+      showCardMove(out, in, player);
       break;
     case BingoTypes::CHECK_CARD :
-      checkCardMove(out, in, id);
+      checkCardMove(out, in, player);
       break;
     case BingoTypes::SHOW_GAME :
-      showGameMove(out, in, id);
+      showGameMove(out, in, player);
       break;
     case BingoTypes::SHOW_BOARD :
-      showBoardMove(out, in, id);
+      showBoardMove(out, in, player);
       break;
     case BingoTypes::HELP :
-      helpMove(out, in, id);
+      helpMove(out, in, player);
       break;
     case BingoTypes::QUIT_GAME :
-      quitGameMove(out, in, id);
+      quitGameMove(out, in, player);
       break;
     default :
       throw function_unavailable("This is not an available move.");
   }
 }
 
-void BingoGame::daubMove(std::ostream& out, std::istream& in,
-                         std::string id) {
-  ScreenDisplay screen;
-  screen.displaySquarePositionPrompt(out);
-  UserInput ui;
-  BingoTypes::squarePos pos = ui.getSquarePosition(in);
+void BingoGame::takeAction(std::ostream& out, const playerAction& action) {
+  if (action.move != BingoTypes::DAUB) {
+    std::istream noInput(nullptr);
+    takeAction(out, noInput, action.player, action.move);
+    return;
+  }
 
-  std::string msg = "Square (" + std::to_string(pos.row) + ", "
-    + std::to_string(pos.col) + ") ";
+  if (_caller == nullptr) {
+    throw incomplete_settings
+    ("Bingo caller is not set, cannot start the game.");
+  }
 
-  if (_player[id]->daubSquare(_caller->getCurrentNumber(), pos)) {
-    msg += "has been daubed.\n";
-  } else {
-    msg += "is already daubed.\n";
+  if (_handles.size() == 0) {
+    throw incomplete_settings
+    ("No players added, cannot start the game.");
   }
 
+  daubAt(out, action.player, action.pos);
+}
+
+BingoGame::packedAction BingoGame::pack(const playerAction& action) {
+  if (action.player > MAX_PACKED_PLAYER) {
+    throw bad_input("The player handle doesn't fit in a packed action.");
+  }
+  if (action.move < 1 || action.move > BingoTypes::NUM_MOVE_TYPES) {
+    throw bad_input("This is not an available move.");
+  }
+  packedAction packed = action.player << 10 | action.move;
+  if (action.move == BingoTypes::DAUB) {
+    if (action.pos.row > 7 || action.pos.col > 7) {
+      throw bad_input("Invalid square position entered.");
+    }
+    packed |= action.pos.row << 4 | action.pos.col << 7;
+  }
+  return packed;
+}
+
+void BingoGame::takeActions(const packedAction* actions,
+                            std::size_t numActions,
+                            std::vector<actionResult>& results) {
+  results.resize(numActions);
+  if (_caller == nullptr || _handles.size() == 0) {
+    std::fill(results.begin(), results.end(), GAME_NOT_READY);
+    return;
+  }
+  for (std::size_t i = 0; i < numActions; ++i) {
+    results[i] = applyAction(actions[i]);
+  }
+}
+
+void BingoGame::displayActionResult(std::ostream& out, packedAction action,
+                                    actionResult result) {
+  playerAction a = unpack(action);
+  ScreenDisplay screen;
+  std::istream noInput(nullptr);
+  std::string msg;
+  switch (result) {
+    case SQUARE_DAUBED :
+    case ALREADY_DAUBED :
+      msg = daubMessage(a.pos, result == SQUARE_DAUBED);
+      break;
+    case BINGO_MET :
+    case BINGO_NOT_MET :
+      msg = bingoMessage(a.player, result == BINGO_MET);
+      break;
+    case UNKNOWN_PLAYER :
+      msg = "Unknown player handle.\n";
+      break;
+    case BAD_MOVE :
+      msg = "This is not an available move.\n";
+      break;
+    case BAD_SQUARE :
+      msg = "Invalid square position entered.\n";
+      break;
+    case GAME_NOT_READY :
+      msg = _caller == nullptr
+        ? "Bingo caller is not set, cannot start the game.\n"
+        : "No players added, cannot start the game.\n";
+      break;
+    case NO_BALL_CALLED :
+      msg = "No balls pulled yet.\n";
+      break;
+    default :
+      // The display moves only show the game, so show it now.
+      takeAction(out, noInput, a.player, a.move);
+      return;
+  }
   screen.displayCallerMessage(out, msg);
 }
 
+BingoGame::playerHandle BingoGame::getPlayerHandle(std::string_view id) {
+  return _handles.find(id);
+}
+
+const std::string& BingoGame::getPlayerId(playerHandle player) {
+  cardOf(player);
+  return _slots[player].id;
+}
+
+void BingoGame::daubMove(std::ostream& out, std::istream& in,
+                         playerHandle player) {
+  ScreenDisplay screen;
+  screen.displaySquarePositionPrompt(out);
+  UserInput ui;
+  daubAt(out, player, ui.getSquarePosition(in));
+}
+
 void BingoGame::bingoMove(std::ostream& out, std::istream& in,
-                          std::string id) {
+                          playerHandle player) {
   ScreenDisplay screen;
-  std::string msg = id + ": Your card has ";
-  if (_player[id]->isVictorious()) {
-    _winners.push_back(id);
-  }  else {
-    msg += "not ";
+  bool met = cardOf(player)->isVictorious(_caller->calledMask());
+  if (met) {
+    _winners.push_back(player);
   }
-  msg += "met the victory conditions for this game.\n";
-  screen.displayCallerMessage(out, msg);
+  if (_journal != nullptr) {
+    _journal->bingoClaimed(player, met);
+  }
+  screen.displayCallerMessage(out, bingoMessage(player, met));
 }
 
 void BingoGame::showCardMove(std::ostream& out, std::istream& in,
-                             std::string id) {
-  std::string msg = id + "\n";
+                             playerHandle player) {
+  std::string msg = getPlayerId(player) + "\n";
   ScreenDisplay screen;
   screen.displayCallerMessage(out, msg);
-  screen.displayBingoCard(out, _player[id]);
+  screen.displayBingoCard(out, cardOf(player));
 }
 
 void BingoGame::checkCardMove(std::ostream& out, std::istream& in,
-                             std::string id) {
+                             playerHandle player) {
   ScreenDisplay screen;
-  screen.displayValidity(out, _player[id]);
-  if (_player[id]->isCorrect()) {
+  BingoCard* card = cardOf(player);
+  screen.displayValidity(out, card);
+  if (card->isCorrect()) {
     screen.displayCallerMessage(out, "No errors found on this card.\n");
   } else {
     screen.displayCallerMessage(out, "Errors found on this card.\n");
@@ -189,24 +477,20 @@ void BingoGame::checkCardMove(std::ostream& out, std::istream& in,
 }
 
 void BingoGame::showGameMove(std::ostream& out, std::istream& in,
-                             std::string id) {
+                             playerHandle) {
   ScreenDisplay screen;
   screen.displayGameInfo(out, _caller);
 }
 
 
-void BingoGame::showBoardMove(std::ostream& out, std::istream& in, std::string id) {
-    // Get the player's bingo card and display it
-    auto it = _player.find(id);
-    if (it != _player.end()) {
-        BingoCard* card = it->second;
-        ScreenDisplay::displayCard(out, card);
-    } else {
-        throw invalid_identifier("Player ID not found.");
-    }
+void BingoGame::showBoardMove(std::ostream& out, std::istream& in,
+                              playerHandle) {
+  ScreenDisplay screen;
+  screen.displayGameBoard(out, _caller);
 }
 
-void BingoGame::helpMove(std::ostream& out, std::istream& in, std::string id) {
+void BingoGame::helpMove(std::ostream& out, std::istream& in,
+                         playerHandle) {
     // Display help instructions to the player
     out << "Welcome to Bingo Game Help!" << std::endl;
     out << "----------------------------------------------" << std::endl;
@@ -219,11 +503,297 @@ void BingoGame::helpMove(std::ostream& out, std::istream& in, std::string id) {
 }
 
 void BingoGame::quitGameMove(std::ostream& out, std::istream& in,
-                             std::string id) {
+                             playerHandle player) {
   ScreenDisplay screen;
-  screen.displayCallerMessage(out, id + " has quit the game.\n");
+  screen.displayCallerMessage(out, getPlayerId(player) +
+                              " has quit the game.\n");
+}
+
+
+void BingoGame::saveSnapshot(const std::string& fileName) {
+  if (_caller == nullptr) {
+    throw incomplete_settings("Bingo caller is not set, cannot save game.");
+  }
+
+  std::string_view handleIds = _handles.getIds();
+  snapshotHeader header;
+  std::memset(static_cast<void*>(&header), 0, sizeof(header));
+  std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+  header.version = SNAPSHOT_VERSION;
+  header.headerSize = sizeof(snapshotHeader);
+  header.cardSize = sizeof(BingoCard);
+  header.autoDaub = _autoDaub;
+  header.numSlots = _slots.size();
+  header.numFree = _freeSlots.size();
+  header.numWinners = _winners.size();
+  header.numBalls = _caller->getNumBalls();
+  for (unsigned ball = 1; ball <= header.numBalls; ++ball) {
+    header.numPostings += _index.getPostings(ball).size();
+  }
+  header.numEntries = _handles.getNumEntries();
+  for (const playerSlot& slot : _slots) {
+    header.idBytes += slot.id.size();
+  }
+  header.handleIdBytes = handleIds.size();
+  _caller->saveState(header.caller);
+
+  snapshotLayout layout(header);
+  std::unique_ptr<char[]> buffer(new char[layout.size]());
+  char* base = buffer.get();
+  std::memcpy(base, &header, sizeof(header));
+
+  std::uint32_t* idEnds = reinterpret_cast<std::uint32_t*>(base
+                                                            + layout.idEnds);
+  char* ids = base + layout.ids;
+  std::uint32_t idEnd = 0;
+  for (unsigned i = 0; i < _slots.size(); ++i) {
+    const playerSlot& slot = _slots[i];
+    if (slot.card != nullptr) {
+      std::memcpy(base + layout.cards + i * sizeof(BingoCard), slot.card,
+                  sizeof(BingoCard));
+      std::memcpy(ids + idEnd, slot.id.data(), slot.id.size());
+      idEnd += slot.id.size();
+    }
+    idEnds[i] = idEnd;
+  }
+  std::copy(_freeSlots.begin(), _freeSlots.end(),
+            reinterpret_cast<std::uint32_t*>(base + layout.freeSlots));
+  std::copy(_winners.begin(), _winners.end(),
+            reinterpret_cast<std::uint32_t*>(base + layout.winners));
+
+  std::uint32_t* counts = reinterpret_cast<std::uint32_t*>(base
+                                                            + layout.counts);
+  NumberIndex::posting* postings =
+    reinterpret_cast<NumberIndex::posting*>(base + layout.postings);
+  for (unsigned ball = 1; ball <= header.numBalls; ++ball) {
+    NumberIndex::postingList list = _index.getPostings(ball);
+    counts[ball - 1] = list.size();
+    postings = std::copy(list.begin(), list.end(), postings);
+  }
+  std::memcpy(base + layout.entries, _handles.getEntries(),
+              header.numEntries * sizeof(FlatIdMap::entry));
+  std::memcpy(base + layout.handleIds, handleIds.data(), handleIds.size());
+
+  writeWholeFile(fileName, base, layout.size);
 }
 
+void BingoGame::restoreSnapshot(const std::string& fileName) {
+  if (_caller == nullptr) {
+    throw incomplete_settings
+    ("Bingo caller is not set, cannot restore game.");
+  }
+
+  std::unique_ptr<MappedFile> file(new MappedFile(fileName, "snapshot",
+                                                  true));
+  std::string_view data = file->getText();
+  std::string damaged = "The snapshot file " + fileName + " is damaged.";
+  snapshotHeader header;
+  if (data.size() < sizeof(header)) {
+    throw bad_input(damaged.c_str());
+  }
+  std::memcpy(static_cast<void*>(&header), data.data(), sizeof(header));
+  if (std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0
+      || header.version != SNAPSHOT_VERSION
+      || header.headerSize != sizeof(snapshotHeader)
+      || header.cardSize != sizeof(BingoCard)) {
+    throw bad_input(("The file " + fileName +
+                     " is not a snapshot of this version.").c_str());
+  }
+  if (header.caller.game != _caller->getGameType()) {
+    throw card_to_game_mismatch("The saved game is of another game type.");
+  }
+  if (header.numBalls != _caller->getNumBalls()
+      || !WinPatterns::isValid(header.caller.victory)
+      || header.numFree > header.numSlots
+      || header.numWinners > header.numSlots
+      || header.numPostings > std::uint64_t{header.numSlots}
+         * WinPatterns::NUM_SQUARES
+      || header.numEntries > data.size()
+      || header.idBytes > data.size()
+      || header.handleIdBytes > data.size()
+      || snapshotLayout(header).size != data.size()) {
+    throw bad_input(damaged.c_str());
+  }
+
+  // Check the whole file before the game is changed.
+  snapshotLayout layout(header);
+  char* base = file->getData();
+  const std::uint32_t* idEnds =
+    reinterpret_cast<const std::uint32_t*>(base + layout.idEnds);
+  const std::uint32_t* freeSlots =
+    reinterpret_cast<const std::uint32_t*>(base + layout.freeSlots);
+  const std::uint32_t* winners =
+    reinterpret_cast<const std::uint32_t*>(base + layout.winners);
+  const std::uint32_t* counts =
+    reinterpret_cast<const std::uint32_t*>(base + layout.counts);
+  const NumberIndex::posting* postings =
+    reinterpret_cast<const NumberIndex::posting*>(base + layout.postings);
+  std::uint32_t idEnd = 0;
+  unsigned numPlayers = 0;
+  for (unsigned i = 0; i < header.numSlots; ++i) {
+    if (idEnds[i] < idEnd || idEnds[i] > header.idBytes) {
+      throw bad_input(damaged.c_str());
+    }
+    numPlayers += idEnds[i] != idEnd;
+    idEnd = idEnds[i];
+  }
+  auto isPlayer = [&](std::uint32_t slot) {
+    return slot < header.numSlots
+      && idEnds[slot] != (slot == 0 ? 0 : idEnds[slot - 1]);
+  };
+  // Each slot without a player is free once, joinGame reuses them.
+  if (header.numFree != header.numSlots - numPlayers) {
+    throw bad_input(damaged.c_str());
+  }
+  std::vector<bool> isFree(header.numSlots, false);
+  for (unsigned i = 0; i < header.numFree; ++i) {
+    if (freeSlots[i] >= header.numSlots || isPlayer(freeSlots[i])
+        || isFree[freeSlots[i]]) {
+      throw bad_input(damaged.c_str());
+    }
+    isFree[freeSlots[i]] = true;
+  }
+  for (unsigned i = 0; i < header.numWinners; ++i) {
+    if (!isPlayer(winners[i])) {
+      throw bad_input(damaged.c_str());
+    }
+  }
+  // The cards and postings are used in place, so a card must be one this
+  // game can play and its squares must have exactly the postings of their
+  // values. The postings are noted by square, then the cards are read in
+  // order, as reading a card for each posting is several times slower.
+  std::uint64_t numPostings = 0;
+  for (unsigned ball = 0; ball < header.numBalls; ++ball) {
+    numPostings += counts[ball];
+  }
+  if (numPostings != header.numPostings) {
+    throw bad_input(damaged.c_str());
+  }
+  std::vector<unsigned char> postedBall(std::size_t{header.numSlots}
+                                        * WinPatterns::NUM_SQUARES, 0);
+  const NumberIndex::posting* p = postings;
+  for (unsigned ball = 1; ball <= header.numBalls; ++ball) {
+    for (const NumberIndex::posting* end = p + counts[ball - 1]; p != end;
+         ++p) {
+      if (p->location >= WinPatterns::NUM_SQUARES
+          || p->card >= header.numSlots || isFree[p->card]) {
+        throw bad_input(damaged.c_str());
+      }
+      unsigned char& square = postedBall[std::size_t{p->card}
+                                         * WinPatterns::NUM_SQUARES
+                                         + p->location];
+      if (square != 0) {
+        throw bad_input(damaged.c_str());
+      }
+      square = ball;
+    }
+  }
+  BingoCard* cards = reinterpret_cast<BingoCard*>(base + layout.cards);
+  BingoTypes::gameType game = _caller->getGameType();
+  const unsigned char* posted = postedBall.data();
+  for (unsigned i = 0; i < header.numSlots; ++i) {
+    if (!isFree[i]) {
+      if (!cards[i].isValidFor(game)) {
+        throw bad_input(damaged.c_str());
+      }
+      for (unsigned j = 0; j < WinPatterns::NUM_SQUARES; ++j) {
+        if (posted[j] != cards[i].getValue(j)) {
+          throw bad_input(damaged.c_str());
+        }
+      }
+    }
+    posted += WinPatterns::NUM_SQUARES;
+  }
+  FlatIdMap handles;
+  handles.restore(
+    reinterpret_cast<FlatIdMap::entry*>(base + layout.entries),
+    header.numEntries,
+    std::string_view(base + layout.handleIds, header.handleIdBytes));
+  if (handles.size() != numPlayers) {
+    throw bad_input(damaged.c_str());
+  }
+  // Each id must lead to its own player's slot, which leaveGame indexes.
+  // The table is read in order, noting where each slot's id is, then the
+  // ids are compared in slot order.
+  const std::uint32_t NO_ENTRY = ~0u;
+  std::vector<std::uint32_t> idOffsetOf(header.numSlots, NO_ENTRY);
+  const FlatIdMap::entry* entries = handles.getEntries();
+  for (std::size_t i = 0; i < handles.getNumEntries(); ++i) {
+    const FlatIdMap::entry& e = entries[i];
+    if (e.state != FlatIdMap::FULL) {
+      continue;
+    }
+    std::uint32_t slot = e.value;
+    if (!isPlayer(slot) || idOffsetOf[slot] != NO_ENTRY
+        || e.idOffset == NO_ENTRY
+        || e.idSize != idEnds[slot] - (slot == 0 ? 0 : idEnds[slot - 1])) {
+      throw bad_input(damaged.c_str());
+    }
+    idOffsetOf[slot] = e.idOffset;
+  }
+  const char* ids = base + layout.ids;
+  const char* handleIds = handles.getIds().data();
+  idEnd = 0;
+  for (unsigned i = 0; i < header.numSlots; ++i) {
+    if (idOffsetOf[i] != NO_ENTRY
+        && std::memcmp(handleIds + idOffsetOf[i], ids + idEnd,
+                       idEnds[i] - idEnd) != 0) {
+      throw bad_input(damaged.c_str());
+    }
+    idEnd = idEnds[i];
+  }
+
+  _caller->restoreState(header.caller);
+  clearPlayers();
+  _autoDaub = header.autoDaub != 0;
+  _handles = std::move(handles);
+
+  // The cards stay in the mapping, a page is copied when it is daubed.
+  _slots.reserve(header.numSlots);
+  idEnd = 0;
+  for (unsigned i = 0; i < header.numSlots; ++i) {
+    _slots.push_back({std::string(ids + idEnd, idEnds[i] - idEnd),
+                      idEnds[i] == idEnd ? nullptr : cards + i});
+    idEnd = idEnds[i];
+  }
+  _freeSlots.assign(freeSlots, freeSlots + header.numFree);
+  _winners.assign(winners, winners + header.numWinners);
+  for (unsigned ball = 1; ball <= header.numBalls; ++ball) {
+    _index.sharePostings(ball, postings, counts[ball - 1]);
+    postings += counts[ball - 1];
+  }
+  _snapshot = std::move(file);
+}
+
+std::size_t BingoGame::replayJournal(const std::string& fileName) {
+  if (_caller == nullptr) {
+    throw incomplete_settings
+    ("Bingo caller is not set, cannot replay the journal.");
+  }
+
+  MappedFile file(fileName, "journal");
+  GameJournal::eventList events =
+    GameJournal::readEvents(file.getText(), _caller->getGameType(), fileName);
+  // The events are in the journal already.
+  GameJournal* journal = _journal;
+  _journal = nullptr;
+  try {
+    for (const GameJournal::event* e = events.begin(); e != events.end(); ) {
+      std::size_t used = applyEvent(e, events.end());
+      if (used == 0) {
+        throw bad_input(("Event " + std::to_string(e->sequence) +
+                         " of the journal file " + fileName +
+                         " doesn't fit the game.").c_str());
+      }
+      e += used;
+    }
+  } catch (...) {
+    _journal = journal;
+    throw;
+  }
+  _journal = journal;
+  return events.size();
+}
 
 bool BingoGame::joinGame(std::string id, BingoCard* card) {
   unsigned count = 0;
@@ -249,50 +819,326 @@ bool BingoGame::joinGame(std::string id, BingoCard* card) {
     throw card_to_game_mismatch("Cannot use this card with this game.");
   }
 
-  if (_player.find(id) != _player.end()) {
+  if (_handles.find(id) != NO_PLAYER) {
     return false;
   }
 
-  _player[id] = card;
+  playerHandle player = _slots.size();
+  if (!_freeSlots.empty()) {
+    player = _freeSlots.back();
+  }
+  _index.addCard(player, card);
+  _handles.insert(id, player);
+  if (player == _slots.size()) {
+    _slots.push_back(playerSlot{std::move(id), card});
+  } else {
+    _freeSlots.pop_back();
+    _slots[player].id = std::move(id);
+    _slots[player].card = card;
+  }
+  if (_journal != nullptr) {
+    _journal->playerJoined(player, _slots[player].id, card);
+  }
 
   return true;
 }
 
 bool BingoGame::leaveGame(std::string id) {
-    auto it = _player.find(id);
-    if (it != _player.end()) {
-        delete it->second;
-        _player.erase(it);
-        return true;
-    }
+  playerHandle player = _handles.find(id);
+  if (player == NO_PLAYER) {
     return false;
+  }
+
+  BingoCard* card = _slots[player].card;
+  _index.removeCard(player, card);
+  destroyCard(card);
+  _handles.erase(id);
+  _slots[player].card = nullptr;
+  _slots[player].id.clear();
+  _freeSlots.push_back(player);
+  // A claim of the player must not be announced for the slot's next player.
+  _winners.erase(std::remove(_winners.begin(), _winners.end(), player),
+                 _winners.end());
+  if (_journal != nullptr) {
+    _journal->playerLeft(player);
+  }
+
+  // Handles stay stable, so a hole stays until a join reuses it. Only the
+  // free slots at the end are dropped.
+  while (!_slots.empty() && _slots.back().card == nullptr) {
+    _freeSlots.erase(std::find(_freeSlots.begin(), _freeSlots.end(),
+                               _slots.size() - 1));
+    _slots.pop_back();
+  }
+  return true;
 }
 
 void BingoGame::endGame(std::ostream& out) {
-    if (!_caller) {
-        throw incomplete_settings("Caller not set.");
-    }
+  if (_caller == nullptr) {
+    throw incomplete_settings("Bingo caller is not set, cannot end the game.");
+  }
 
-    // Check for winners
-    for (auto& pair : _player) {
-        BingoCard* card = pair.second;
-        if (card->checkForWin(_caller->getVictoryType())) {
-            _winners.push_back(pair.first);
-        }
+  CardBatch batch(_caller->getVictoryType());
+  for (playerSlot& slot : _slots) {
+    batch.addCard(slot.card == nullptr ? 0 : slot.card->getDaubMask());
+  }
+
+  std::vector<std::uint64_t> winners = batch.findWinners();
+  for (playerHandle player = 0; player < _slots.size(); ++player) {
+    if (_slots[player].card != nullptr
+        && (winners[player / 64] >> (player % 64)) & 1
+        && std::find(_winners.begin(), _winners.end(), player)
+           == _winners.end()) {
+      _winners.push_back(player);
     }
+  }
 
-    // If there are winners or no more players, end the game
-    if (!_winners.empty() || _player.empty()) {
-        ScreenDisplay::displayWinners(out, _winners);
-        // Reset the game after ending
-        resetGame();
+  bool cageEmpty = _caller->getNumBallsPulled() == _caller->getNumBalls();
+  if (!_winners.empty() || _handles.size() == 0 || cageEmpty) {
+    ScreenDisplay screen;
+    std::string msg = "The game is over.";
+    if (!_winners.empty()) {
+      msg += " Bingo for";
+      for (playerHandle player : _winners) {
+        msg += " " + _slots[player].id;
+      }
+      msg += "!";
+    } else if (_handles.size() != 0) {
+      msg += " Nobody won.";
     }
+    screen.displayCallerMessage(out, msg + "\n");
+    resetGame();
+  }
 }
 
 void BingoGame::resetGame() {
-    _winners.clear();
-    for (auto& pair : _player) {
-        delete pair.second;
+  if (_caller == nullptr) {
+    throw incomplete_settings("Bingo caller is not set, cannot reset game.");
+  }
+
+  _caller->resetGame();
+  clearPlayers();
+  if (_journal != nullptr) {
+    _journal->gameReset();
+  }
+}
+
+void BingoGame::clearPlayers() {
+  _winners.clear();
+  for (playerSlot& slot : _slots) {
+    destroyCard(slot.card);
+  }
+  _slots.clear();
+  _freeSlots.clear();
+  _handles.clear();
+  _arena.release();
+  _index.reset(_caller->getNumBalls());
+  _snapshot.reset();
+}
+
+void BingoGame::destroyCard(BingoCard* card) {
+  // The cards of a snapshot are unmapped with it.
+  if (_snapshot == nullptr || !_snapshot->contains(card)) {
+    CardArena::destroy(&_arena, card);
+  }
+}
+
+void BingoGame::daubCalledNumber(unsigned ball) {
+  for (const NumberIndex::posting& entry : _index.getPostings(ball)) {
+    BingoCard* card = entry.card < _slots.size() ? _slots[entry.card].card
+      : nullptr;
+    if (card != nullptr && card->daubSquare(ball, entry.location)
+        && card->completesVictory(entry.location)) {
+      _winners.push_back(entry.card);
     }
-    _player.clear();
+  }
+}
+
+std::size_t BingoGame::applyEvent(const GameJournal::event* e,
+                                  const GameJournal::event* end) {
+  bool isPlayer = e->player < _slots.size()
+    && _slots[e->player].card != nullptr;
+  switch (e->type) {
+    case GameJournal::BALL_PULLED :
+      if (!_caller->pullBall(e->ball)) {
+        return 0;
+      }
+      _autoDaub = e->flag != 0;
+      if (_autoDaub) {
+        daubCalledNumber(e->ball);
+      }
+      return 1;
+    case GameJournal::SQUARE_DAUBED :
+      if (!isPlayer || e->location >= WinPatterns::NUM_SQUARES) {
+        return 0;
+      }
+      _slots[e->player].card->daubSquare(e->ball, e->location);
+      return 1;
+    case GameJournal::BINGO_CLAIMED :
+      if (!isPlayer) {
+        return 0;
+      }
+      if (e->flag != 0) {
+        _winners.push_back(e->player);
+      }
+      return 1;
+    case GameJournal::PLAYER_JOINED : {
+      // The id goes on in the ID_PART events after the join.
+      std::size_t numParts = GameJournal::numIdParts(e->size);
+      playerHandle player = _freeSlots.empty() ? _slots.size()
+        : _freeSlots.back();
+      if (numParts >= static_cast<std::size_t>(end - e)
+          || e->player != player) {
+        return 0;
+      }
+      std::string id(reinterpret_cast<const char*>(e->data)
+                     + WinPatterns::NUM_SQUARES,
+                     std::min<std::size_t>(e->size,
+                                           GameJournal::JOIN_ID_BYTES));
+      for (std::size_t i = 1; i <= numParts; ++i) {
+        if (e[i].type != GameJournal::ID_PART || e[i].player != player) {
+          return 0;
+        }
+        id.append(reinterpret_cast<const char*>(e[i].data),
+                  std::min<std::size_t>(e->size - id.size(),
+                                        GameJournal::PART_ID_BYTES));
+      }
+
+      BingoTypes::victoryType victory =
+        static_cast<BingoTypes::victoryType>(e->flag);
+      if (!WinPatterns::isValid(victory)) {
+        return 0;
+      }
+      BingoCard::gridType grid;
+      for (unsigned i = 0; i < WinPatterns::NUM_SQUARES; ++i) {
+        if (e->data[i] == 0) {
+          grid[i] = FreeSquare();
+        } else {
+          grid[i] = IntSquare(e->data[i]);
+        }
+      }
+      BingoCard* card = _arena.make<BingoCard>(grid, _caller->getGameType());
+      card->setVictoryType(victory);
+      if (!joinGame(std::move(id), card)) {
+        CardArena::destroy(&_arena, card);
+        return 0;
+      }
+      return numParts + 1;
+    }
+    case GameJournal::PLAYER_LEFT :
+      if (!isPlayer) {
+        return 0;
+      }
+      leaveGame(_slots[e->player].id);
+      return 1;
+    case GameJournal::GAME_RESET :
+      resetGame();
+      return 1;
+    case GameJournal::GAME_SETTINGS : {
+      BingoTypes::victoryType victory =
+        static_cast<BingoTypes::victoryType>(e->flag);
+      if (!WinPatterns::isValid(victory)) {
+        return 0;
+      }
+      // The victory type only changes between games, as when recorded.
+      if (victory != _caller->getVictoryType()) {
+        if (_caller->getNumBallsPulled() > 0) {
+          return 0;
+        }
+        _caller->setVictoryType(victory);
+      }
+      _autoDaub = e->size != 0;
+      return 1;
+    }
+    default :
+      return 0;
+  }
+}
+
+BingoGame::actionResult BingoGame::applyAction(packedAction action) {
+  playerAction a = unpack(action);
+  if (a.player >= _slots.size() || _slots[a.player].card == nullptr) {
+    return UNKNOWN_PLAYER;
+  }
+  BingoCard* card = _slots[a.player].card;
+
+  switch (a.move) {
+    case BingoTypes::DAUB : {
+      if (a.pos.row < 1 || a.pos.row > WinPatterns::NUM_ROWS ||
+          a.pos.col < 1 || a.pos.col > WinPatterns::NUM_COLS) {
+        return BAD_SQUARE;
+      }
+      if (_caller->getNumBallsPulled() == 0) {
+        return NO_BALL_CALLED;
+      }
+      unsigned ball = _caller->getCurrentNumber();
+      unsigned location = WinPatterns::location(a.pos.row - 1, a.pos.col - 1);
+      if (!card->daubSquare(ball, location)) {
+        return ALREADY_DAUBED;
+      }
+      if (_journal != nullptr) {
+        _journal->squareDaubed(a.player, ball, location);
+      }
+      return SQUARE_DAUBED;
+    }
+    case BingoTypes::BINGO :
+      if (!card->isVictorious(_caller->calledMask())) {
+        if (_journal != nullptr) {
+          _journal->bingoClaimed(a.player, false);
+        }
+        return BINGO_NOT_MET;
+      }
+      _winners.push_back(a.player);
+      if (_journal != nullptr) {
+        _journal->bingoClaimed(a.player, true);
+      }
+      return BINGO_MET;
+    case BingoTypes::CHECK_CARD :
+      return card->isCorrect() ? CARD_CORRECT : CARD_ERRORS;
+    case BingoTypes::SHOW_CARD :
+    case BingoTypes::SHOW_GAME :
+    case BingoTypes::SHOW_BOARD :
+    case BingoTypes::HELP :
+      return ACTION_DONE;
+    case BingoTypes::QUIT_GAME :
+      return PLAYER_QUIT;
+    default :
+      return BAD_MOVE;
+  }
+}
+
+BingoCard* BingoGame::cardOf(playerHandle player) {
+  if (player >= _slots.size() || _slots[player].card == nullptr) {
+    throw invalid_identifier("Unknown player handle.");
+  }
+  return _slots[player].card;
+}
+
+void BingoGame::daubAt(std::ostream& out, playerHandle player,
+                       BingoTypes::squarePos pos) {
+  BingoCard* card = cardOf(player);
+  unsigned ball = _caller->getCurrentNumber();
+  bool daubed = card->daubSquare(ball, pos);
+  if (daubed && _journal != nullptr) {
+    _journal->squareDaubed(player, ball,
+                           WinPatterns::location(pos.row - 1, pos.col - 1));
+  }
+  ScreenDisplay screen;
+  screen.displayCallerMessage(out, daubMessage(pos, daubed));
+}
+
+std::string BingoGame::daubMessage(BingoTypes::squarePos pos, bool daubed) {
+  std::string msg = "Square (" + std::to_string(pos.row) + ", "
+    + std::to_string(pos.col) + ") ";
+  msg += daubed ? "has been daubed.\n" : "is already daubed.\n";
+  return msg;
+}
+
+std::string BingoGame::bingoMessage(playerHandle player, bool met) {
+  std::string msg = getPlayerId(player) + ": Your card has ";
+  if (!met) {
+    msg += "not ";
+  }
+  msg += "met the victory conditions for this game.\n";
+  return msg;
 }
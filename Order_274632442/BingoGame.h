@@ -2,13 +2,21 @@
 #ifndef BINGOGAME_H_INCLUDED
 #define BINGOGAME_H_INCLUDED
 
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
-#include <map>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "BingoCaller.h"
 #include "BingoCard.h"
+#include "CardArena.h"
+#include "FlatIdMap.h"
+#include "GameJournal.h"
+#include "MappedFile.h"
+#include "NumberIndex.h"
 #include "VictoryCondition.h"
 
 /**
@@ -17,6 +25,55 @@
  */
 class BingoGame {
  public:
+  /**< A player's slot, from joinGame until the player leaves. >**/
+  typedef unsigned playerHandle;
+
+  /**< The handle of no player. >**/
+  static const playerHandle NO_PLAYER = FlatIdMap::NOT_FOUND;
+
+  /**
+   * @brief A move with its input already parsed, e.g. by a network thread.
+   */
+  struct playerAction {
+    playerHandle player;
+    BingoTypes::moveType move;
+    /**< The square to daub, only used by DAUB. >**/
+    BingoTypes::squarePos pos;
+  };
+
+  /**< A playerAction in 32 bits, the move in bits 0 to 3, the row in bits
+   4 to 6, the column in bits 7 to 9 and the player in bits 10 to 31. >**/
+  typedef std::uint32_t packedAction;
+
+  /**< The largest player handle a packedAction holds. >**/
+  static const playerHandle MAX_PACKED_PLAYER = (1u << 22) - 1;
+
+  /**< The outcome of a packed action, in one byte. NO_BALL_CALLED is a
+   DAUB before the first ball. >**/
+  enum actionResult : std::uint8_t {ACTION_DONE, SQUARE_DAUBED,
+    ALREADY_DAUBED, BINGO_MET, BINGO_NOT_MET, CARD_CORRECT, CARD_ERRORS,
+    PLAYER_QUIT, UNKNOWN_PLAYER, BAD_MOVE, BAD_SQUARE, GAME_NOT_READY,
+    NO_BALL_CALLED};
+
+  /**
+   * @brief Pack an action.
+   * @param [in] action The action, pos is ignored unless it is a DAUB.
+   * @return The packed action.
+   * @throw bad_input If the player is over MAX_PACKED_PLAYER, or the move
+   *   or the position doesn't fit.
+   */
+  static packedAction pack(const playerAction& action);
+
+  /**
+   * @brief Unpack an action, the fields are not checked.
+   * @param [in] action The packed action.
+   * @return The action.
+   */
+  static playerAction unpack(packedAction action) {
+    return {action >> 10, static_cast<BingoTypes::moveType>(action & 0xf),
+            {(action >> 4) & 0x7, (action >> 7) & 0x7}};
+  }
+
   /**
    * @brief Default constructor.
    * @details Sets _caller to nullptr.
@@ -42,6 +99,14 @@ class BingoGame {
    */
   BingoTypes::victoryType getVictoryType();
 
+  /**
+   * @brief Access the arena the game's cards should be made in.
+   * @details Pass it to BingoCardFactory::makeBingoCard, cards made in it are
+   *   released all at once by resetGame.
+   * @return A pointer to this game's CardArena.
+   */
+  CardArena* getCardArena();
+
   /**
    * @brief Access the number of players.
    * @return The number of players.
@@ -64,11 +129,45 @@ class BingoGame {
   void resetVictoryType(BingoTypes::victoryType victory);
 
   /**
-   * @brief If there are any winners or there are no more players then
-   *   the game ends, otherwise another ball is pulled and announced.
+   * @brief Access the auto daub mode.
+   * @return true, if called balls are daubed for the players.
+   */
+  bool getAutoDaub();
+
+  /**
+   * @brief Choose whether called balls are daubed for the players.
+   * @details With auto daub on, which is the default, every round daubs the
+   *   ball on all the cards holding it and ends the game for the cards it
+   *   completes. With it off, players daub with daubMove and claim with
+   *   bingoMove.
+   * @param [in] autoDaub true to daub for the players.
+   * @throw function_unavailable If a game has started but not ended.
+   */
+  void setAutoDaub(bool autoDaub);
+
+  /**
+   * @brief Record every change to the game in a journal.
+   * @details The journal should start from the game's state now, a new
+   *   game or the one just saved by saveSnapshot. The victory type and
+   *   auto daub are recorded first and again whenever they change. Each
+   *   round commits the journal once, after the ball is pulled, so the
+   *   moves before it are synced together.
+   * @param [in] journal The journal, or nullptr to stop recording.
+   */
+  void setJournal(GameJournal* journal);
+
+  /**
+   * @brief Play one round: pull one ball, announce it to every player, then
+   *   end the game if there are any winners.
+   * @details A bingo claimed since the last round ends the game before
+   *   another ball is pulled. With auto daub on, only the cards holding the
+   *   ball, as found in the NumberIndex, are daubed and checked for
+   *   victory, in one pass that collects every card the ball completes, so
+   *   a round costs one step per affected square.
    * @param [inout] out Insert prompts and information in this ostream.
    * @throw incomplete_settings If the caller hasn't been set.
    * @throw invalid_size If there are no players before the first turn.
+   * @throw bad_input If the journal can't be written.
    */
   void completeNextCall(std::ostream& out);
 
@@ -93,78 +192,197 @@ class BingoGame {
   void takeAction(std::ostream& out, std::istream& in,
                   std::string id, BingoTypes::moveType move);
 
+  /**
+   * @brief Complete a user action of a player already looked up.
+   * @details Sessions resolve their id once with getPlayerHandle and then
+   *   take every action by handle, which indexes the player table instead
+   *   of hashing the id.
+   * @param [inout] out Insert prompts and information in this ostream.
+   * @param [inout] in Extract data from this istream.
+   * @param [in] player The handle of the player requesting this action.
+   * @param [in] move The moveType to be completed.
+   * @throw incomplete_settings If the caller hasn't been set.
+   * @throw invalid_size If there are no players.
+   * @throw invalid_identifier If the handle isn't a player's.
+   */
+  void takeAction(std::ostream& out, std::istream& in,
+                  playerHandle player, BingoTypes::moveType move);
+
+  /**
+   * @brief Complete a user action that needs no prompt.
+   * @details A DAUB daubs action.pos instead of reading a position from an
+   *   istream, the other moves are the same as with takeAction by handle.
+   * @param [inout] out Insert prompts and information in this ostream.
+   * @param [in] action The action.
+   * @throw incomplete_settings If the caller hasn't been set.
+   * @throw invalid_size If there are no players.
+   * @throw invalid_identifier If the handle isn't a player's.
+   * @throw invalid_square If a DAUB's position isn't on the card.
+   */
+  void takeAction(std::ostream& out, const playerAction& action);
+
+  /**
+   * @brief Apply a batch of packed actions, for automated clients.
+   * @details Nothing is displayed and nothing is thrown: each action gets a
+   *   result code instead, and a failed action doesn't stop the batch. The
+   *   display moves have no effect here, displayActionResult renders any
+   *   action as text afterwards.
+   * @param [in] actions The actions, applied in order.
+   * @param [in] numActions The number of actions.
+   * @param [out] results Replaced by the result of each action.
+   */
+  void takeActions(const packedAction* actions, std::size_t numActions,
+                   std::vector<actionResult>& results);
+
+  /**
+   * @brief Display an action taken by takeActions as takeAction would.
+   * @param [inout] out Insert prompts and information in this ostream.
+   * @param [in] action The packed action.
+   * @param [in] result Its result.
+   */
+  void displayActionResult(std::ostream& out, packedAction action,
+                           actionResult result);
+
+  /**
+   * @brief Look up the handle of a player.
+   * @param [in] id The id of a player.
+   * @return The player's handle, NO_PLAYER if id isn't in the game.
+   */
+  playerHandle getPlayerHandle(std::string_view id);
+
+  /**
+   * @brief Access the id of a player.
+   * @param [in] player The handle of a player.
+   * @return The player's id.
+   * @throw invalid_identifier If the handle isn't a player's.
+   */
+  const std::string& getPlayerId(playerHandle player);
+
   /**
    * @brief Complete a daub square user action.
    * @param [inout] out Insert prompts and information in this ostream.
    * @param [inout] in Extract data from this istream.
-   * @param [in] id The id of the player requesting this action.
+   * @param [in] player The handle of the player requesting this action.
    */
-  void daubMove(std::ostream& out, std::istream& in, std::string id);
+  void daubMove(std::ostream& out, std::istream& in, playerHandle player);
 
   /**
    * @brief Complete a say bingo user action.
    * @param [inout] out Insert prompts and information in this ostream.
    * @param [inout] in Extract data from this istream.
-   * @param [in] id The id of the player requesting this action.
+   * @param [in] player The handle of the player requesting this action.
    */
-  void bingoMove(std::ostream& out, std::istream& in, std::string id);
+  void bingoMove(std::ostream& out, std::istream& in, playerHandle player);
 
   /**
    * @brief Complete a request for card display user action.
    * @param [inout] out Insert prompts and information in this ostream.
    * @param [inout] in Extract data from this istream.
-   * @param [in] id The id of the player requesting this action.
+   * @param [in] player The handle of the player requesting this action.
    */
-  void showCardMove(std::ostream& out, std::istream& in, std::string id);
+  void showCardMove(std::ostream& out, std::istream& in, playerHandle player);
 
   /**
    * @brief Complete a request card checked for validity user action.
    * @param [inout] out Insert prompts and information in this ostream.
    * @param [inout] in Extract data from this istream.
-   * @param [in] id The id of the player requesting this action.
+   * @param [in] player The handle of the player requesting this action.
    */
-  void checkCardMove(std::ostream& out, std::istream& in, std::string id);
+  void checkCardMove(std::ostream& out, std::istream& in, playerHandle player);
 
   /**
    * @brief Complete a request for game and victory type for this game.
    * @param [inout] out Insert prompts and information in this ostream.
    * @param [inout] in Extract data from this istream.
-   * @param [in] id The id of the player requesting this action.
+   * @param [in] player The handle of the player requesting this action.
    */
-  void showGameMove(std::ostream& out, std::istream& in, std::string id);
+  void showGameMove(std::ostream& out, std::istream& in, playerHandle player);
 
   /**
    * @brief Complete a request to see all the pulled balls user action.
    * @param [inout] out Insert prompts and information in this ostream.
    * @param [inout] in Extract data from this istream.
-   * @param [in] id The id of the player requesting this action.
+   * @param [in] player The handle of the player requesting this action.
    */
-  void showBoardMove(std::ostream& out, std::istream& in, std::string id);
+  void showBoardMove(std::ostream& out, std::istream& in, playerHandle player);
 
   /**
    * @brief Complete a request to see the help data user action.
    * @param [inout] out Insert prompts and information in this ostream.
    * @param [inout] in Extract data from this istream.
-   * @param [in] id The id of the player requesting this action.
+   * @param [in] player The handle of the player requesting this action.
    */
-  void helpMove(std::ostream& out, std::istream& in, std::string id);
+  void helpMove(std::ostream& out, std::istream& in, playerHandle player);
 
   /**
    * @brief Complete a player has quit action.
    * @param [inout] out Insert prompts and information in this ostream.
    * @param [inout] in Extract data from this istream.
-   * @param [in] id The id of the player requesting this action.
+   * @param [in] player The handle of the player requesting this action.
+   */
+  void quitGameMove(std::ostream& out, std::istream& in, playerHandle player);
+
+  /**
+   * @brief Save the whole game to a file in one sequential write.
+   * @details The snapshot holds the caller's draw and stream, the auto daub
+   *   mode, every player with their handle and daubed card, the number
+   *   index and the bingo claims not yet answered by a round. It is written
+   *   to fileName.tmp, synced and renamed, so fileName is always a whole
+   *   snapshot. It can only be restored by a build with the same version
+   *   and card layout.
+   * @param [in] fileName The name of the file.
+   * @throw incomplete_settings If the caller hasn't been set.
+   * @throw bad_input If the file can't be written.
+   */
+  void saveSnapshot(const std::string& fileName);
+
+  /**
+   * @brief Replace the game with a saved one.
+   * @details The file is mapped privately and the game runs on it in
+   *   place: the players' card pointers are set into the mapping, which
+   *   copies a page only when a card on it is daubed, the index reads each
+   *   ball's postings from it until they change, and the handle table is
+   *   loaded as is. So no card is rebuilt square by square and no id is
+   *   hashed. The mapping is dropped by the next resetGame. The game's
+   *   caller takes the saved draw and stream. The cards, slots, claims,
+   *   postings and handles are all checked first, so the game is left as
+   *   it was if any of them is damaged.
+   * @param [in] fileName The name of the file.
+   * @throw incomplete_settings If the caller hasn't been set.
+   * @throw bad_input If the file can't be read, or isn't a whole and
+   *   consistent snapshot of this version.
+   * @throw card_to_game_mismatch If the caller is of another game type.
+   */
+  void restoreSnapshot(const std::string& fileName);
+
+  /**
+   * @brief Apply the events of a journal to the game.
+   * @details The game must be in the state the journal started from. The
+   *   events are applied directly, without prompts, moves or checks of the
+   *   card numbers against the balls, and are not recorded again. The
+   *   balls are pulled in the journal's order, so the caller draws no
+   *   random number for them. The journal ends at its first torn or
+   *   damaged event.
+   * @param [in] fileName The name of the journal file.
+   * @return The number of events applied.
+   * @throw incomplete_settings If the caller hasn't been set.
+   * @throw bad_input If the file can't be read or isn't a journal of this
+   *   version, or an event doesn't fit the game. The events before it are
+   *   applied.
+   * @throw card_to_game_mismatch If the journal is of another game type.
    */
-  void quitGameMove(std::ostream& out, std::istream& in, std::string id);
+  std::size_t replayJournal(const std::string& fileName);
 
   /**
    * @brief Add a player to the caller's current game.
    * @details The identifier must be distinct in the player list, and the id
    *   must not be blank. The bingo card must be the correct type for the
-   *   bingo caller's current game.
+   *   bingo caller's current game. The card's squares are added to the
+   *   NumberIndex.
    * @param [in] id An identifier for the player.
    * @param [in] card A pointer to a bingo card.
-   * @return true if the player is added, false otherwise
+   * @return true if the player is added, false otherwise. The player's
+   *   handle is then the value of getPlayerHandle.
    * @throw invalid_identifier if the id is blank.
    * @throw card_to_game_mismatch if the card isn't for this game.
    */
@@ -172,7 +390,12 @@ class BingoGame {
 
   /**
    * @brief Remove the entry for this id from the players.
-   * @details The memory allocated for the player's bingo card is deallocated.
+   * @details The card's postings are removed from the NumberIndex and the
+   *   player's bingo card is destroyed, if it was made in the game's arena
+   *   its memory is reclaimed by the next resetGame. A claim of bingo by
+   *   the player is withdrawn. The player's slot is reused by the next
+   *   player to join, free slots at the end of the table are dropped, the
+   *   others stay as holes so the other handles don't change.
    * @param [in] id The id of the player leaving.
    * @return true if the player is found and removed, false otherwise.
    */
@@ -180,22 +403,114 @@ class BingoGame {
 
   /**
    * @brief Makes an appropriate end of game announcement.
-   * @details The game ends if there are no players or there are one or
-   *   more players that called bingo and have met the victory conditions.
+   * @details The game ends if there are no players, if there are one or
+   *   more players that called bingo and have met the victory conditions,
+   *   or if every ball has been called, then with no winner. All the cards
+   *   are checked at once with a CardBatch.
    * @param [inout] out Insert prompts and information in this ostream.
    * @throw incomplete_settings If the caller hasn't been set
    */
   void endGame(std::ostream& out);
 
   /**
-   * @brief Reset the bingo caller, and clear the player list.
+   * @brief Reset the bingo caller, and clear the player list and index.
+   * @details The cards are destroyed and the card arena is released in bulk.
    * @throw incomplete_settings If the caller hasn't been set
    */
   void resetGame();
 
  private:
   BingoCaller* _caller;
-  std::map<std::string, BingoCard*> _player;
-  std::vector<std::string> _winners;
+  bool _autoDaub;
+  GameJournal* _journal;
+  CardArena _arena;
+  /**< A player's slot, card is a nullptr while the slot is free. >**/
+  struct playerSlot {
+    std::string id;
+    BingoCard* card;
+  };
+  /**< Indexed by playerHandle, the handle is also the card id in _index. >**/
+  std::vector<playerSlot> _slots;
+  std::vector<playerHandle> _freeSlots;
+  /**< The handle of each player id. >**/
+  FlatIdMap _handles;
+  std::vector<playerHandle> _winners;
+  NumberIndex _index;
+  /**< The restored snapshot, its cards and postings are used in place. >**/
+  std::unique_ptr<MappedFile> _snapshot;
+
+  /**
+   * @brief Apply one packed action.
+   * @param [in] action The packed action.
+   * @return Its result.
+   */
+  actionResult applyAction(packedAction action);
+
+  /**
+   * @brief Daub a square for a player and report it.
+   * @param [inout] out Insert prompts and information in this ostream.
+   * @param [in] player The handle of the player.
+   * @param [in] pos The position of the square.
+   */
+  void daubAt(std::ostream& out, playerHandle player,
+              BingoTypes::squarePos pos);
+
+  /**
+   * @brief The report of a daub.
+   * @param [in] pos The position of the square.
+   * @param [in] daubed true, if the square was daubed, false if it already
+   *   was.
+   * @return The message.
+   */
+  static std::string daubMessage(BingoTypes::squarePos pos, bool daubed);
+
+  /**
+   * @brief The answer to a bingo claim.
+   * @param [in] player The handle of the player claiming.
+   * @param [in] met true, if the card meets the victory conditions.
+   * @return The message.
+   */
+  std::string bingoMessage(playerHandle player, bool met);
+
+  /**
+   * @brief Destroy the cards and empty the player table and the index.
+   */
+  void clearPlayers();
+
+  /**
+   * @brief Destroy a player's card, unless it is in the snapshot.
+   * @param [in] card The card, can be a nullptr.
+   */
+  void destroyCard(BingoCard* card);
+
+  /**
+   * @brief Check a handle.
+   * @param [in] player A handle.
+   * @return The player's card.
+   * @throw invalid_identifier If the handle isn't a player's.
+   */
+  BingoCard* cardOf(playerHandle player);
+
+  /**
+   * @brief Pull the next ball, announce it and end the game if it's won.
+   * @param [inout] out Insert prompts and information in this ostream.
+   */
+  void callNext(std::ostream& out);
+
+  /**
+   * @brief Apply one event of a journal.
+   * @param [in] e The event.
+   * @param [in] end The end of the journal's events.
+   * @return The events used, more than one for a long id.
+   * @throw bad_input If the event doesn't fit the game.
+   */
+  std::size_t applyEvent(const GameJournal::event* e,
+                         const GameJournal::event* end);
+
+  /**
+   * @brief Daub the ball on every card holding it and collect the winners.
+   * @param [in] ball The value of the ball that was called.
+   */
+  void daubCalledNumber(unsigned ball);
 };
 #endif // BINGOGAME_H_INCLUDED
@@ -2,6 +2,9 @@
 #ifndef BINGOTYPES_H_INCLUDED
 #define BINGOTYPES_H_INCLUDED
 
+#include <array>
+#include <cstdint>
+
 /**
 * @class BingoTypes BingoTypes.h "BingoTypes.h"
 * @brief A collection of types and constants.
@@ -10,6 +13,11 @@ class BingoTypes {
  public:
   enum gameType {BINGO75 = 75, BINGO50 = 50};
 
+  /**< The most balls any game type uses. >**/
+  static const unsigned MAX_BALLS = 128;
+  /**< Bit n of word n / 64 is set for each ball n in a set of balls. >**/
+  typedef std::array<std::uint64_t, MAX_BALLS / 64> ballMask;
+
   static const unsigned NUM_VICTORY_TYPES = 4;
   enum victoryType {HORIZONTAL_LINE = 1, VERTICAL_LINE, ANY_LINE, BLACKOUT};
 
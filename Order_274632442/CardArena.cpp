@@ -0,0 +1,84 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory_resource>
+#include <new>
+
+#include "CardArena.h"
+
+CardArena::CardArena(std::size_t blockSize)
+  : _next{nullptr}, _end{nullptr}, _blockSize{blockSize}, _bytesUsed{0} {}
+
+CardArena::~CardArena() {
+  for (block& b : _blocks) {
+    ::operator delete(b.begin);
+  }
+}
+
+bool CardArena::owns(const void* p) {
+  std::less<const void*> before;
+  auto after = std::upper_bound(_sorted.begin(), _sorted.end(), p,
+                                [&before](const void* q, const block& b) {
+                                  return before(q, b.begin);
+                                });
+  if (after == _sorted.begin()) {
+    return false;
+  }
+  --after;
+  return before(p, after->begin + after->size);
+}
+
+void CardArena::release() {
+  if (_blocks.empty()) {
+    return;
+  }
+  for (unsigned i = 1; i < _blocks.size(); ++i) {
+    ::operator delete(_blocks[i].begin);
+  }
+  _blocks.resize(1);
+  _sorted.assign(1, _blocks[0]);
+  _next = _blocks[0].begin;
+  _end = _blocks[0].begin + _blocks[0].size;
+  _bytesUsed = 0;
+}
+
+std::size_t CardArena::getBytesUsed() {
+  return _bytesUsed;
+}
+
+void* CardArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+  std::uintptr_t next = reinterpret_cast<std::uintptr_t>(_next);
+  std::uintptr_t aligned = (next + alignment - 1) & ~(alignment - 1);
+  std::uintptr_t end = reinterpret_cast<std::uintptr_t>(_end);
+
+  if (_next == nullptr || aligned + bytes > end) {
+    addBlock(std::max(_blockSize, bytes + alignment));
+    next = reinterpret_cast<std::uintptr_t>(_next);
+    aligned = (next + alignment - 1) & ~(alignment - 1);
+  }
+
+  _next = reinterpret_cast<char*>(aligned + bytes);
+  _bytesUsed += bytes;
+  return reinterpret_cast<void*>(aligned);
+}
+
+void CardArena::do_deallocate(void*, std::size_t, std::size_t) {}
+
+bool CardArena::do_is_equal(const std::pmr::memory_resource& other)
+  const noexcept {
+  return this == &other;
+}
+
+void CardArena::addBlock(std::size_t size) {
+  char* begin = static_cast<char*>(::operator new(size));
+  _blocks.push_back({begin, size});
+  std::less<const void*> before;
+  auto at = std::upper_bound(_sorted.begin(), _sorted.end(), begin,
+                             [&before](const char* p, const block& b) {
+                               return before(p, b.begin);
+                             });
+  _sorted.insert(at, {begin, size});
+  _next = begin;
+  _end = begin + size;
+}
@@ -0,0 +1,147 @@
+#ifndef CARD_ARENA_H_INCLUDED
+#define CARD_ARENA_H_INCLUDED
+
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+* @class CardArena CardArena.h "CardArena.h"
+* @brief Monotonic memory for the bingo cards of one game.
+* @details Memory is handed out from large blocks by bumping a pointer and
+*   is only given back, all at once, by release. The cards of a game are
+*   laid out one after the other in a few blocks, and are freed with a few
+*   deallocations instead of one per card. The arena is also a
+*   memory_resource so pmr containers can use it.
+*/
+class CardArena : public std::pmr::memory_resource {
+ public:
+  /**
+  * @brief Default constructor, no memory is allocated until it is needed.
+  * @param [in] blockSize The size in bytes of the blocks requested from
+  *   the heap.
+  */
+  explicit CardArena(std::size_t blockSize = 64 * 1024);
+
+  /**
+  * @brief Copy constructor, disabled.
+  * @param arena a CardArena class object.
+  */
+  CardArena(const CardArena& arena) = delete;
+
+  /**
+  * @brief Assignment operator, disabled.
+  * @param arena a CardArena class object.
+  */
+  void operator=(const CardArena& arena) = delete;
+
+  /**
+  * @brief Destructor, deallocates all the blocks.
+  * @details Objects still in the arena are not destroyed.
+  */
+  virtual ~CardArena();
+
+  /**
+  * @brief Construct an object in the arena.
+  * @param [in] args The arguments for T's constructor.
+  * @return A pointer to the new object, to be destroyed with destroy.
+  */
+  template <typename T, typename... Args>
+  T* make(Args&&... args) {
+    void* memory = allocate(sizeof(T), alignof(T));
+    return new (memory) T(std::forward<Args>(args)...);
+  }
+
+  /**
+  * @brief Destroy an object made by make, or by new if it isn't in arena.
+  * @details Arena memory is only reclaimed by release, so objects in the
+  *   arena are only destructed, and not even that when T is trivially
+  *   destructible.
+  * @param [in] arena The arena the object may be in, can be a nullptr.
+  * @param [in] object The object to destroy, can be a nullptr.
+  */
+  template <typename T>
+  static void destroy(CardArena* arena, T* object) {
+    if (object == nullptr) {
+      return;
+    }
+    if (arena != nullptr && arena->owns(object)) {
+      if constexpr (!std::is_trivially_destructible<T>::value) {
+        object->~T();
+      }
+    } else {
+      delete object;
+    }
+  }
+
+  /**
+  * @brief Determines if p points into memory handed out by the arena.
+  * @details A binary search of the blocks by address, so destroying every
+  *   card of a game costs a few comparisons per card.
+  * @param [in] p Any pointer.
+  * @return true, if p is in one of the arena's blocks, false otherwise.
+  */
+  bool owns(const void* p);
+
+  /**
+  * @brief Give back everything allocated from the arena in one step.
+  * @details Every object in the arena must already be destroyed. The first
+  *   block is kept for the next game.
+  */
+  void release();
+
+  /**
+  * @brief Access the number of bytes handed out since the last release.
+  * @return The number of bytes used.
+  */
+  std::size_t getBytesUsed();
+
+ protected:
+  /**
+  * @brief Hand out bytes from the current block, starting a new block if
+  *   there isn't room.
+  * @param [in] bytes The number of bytes needed.
+  * @param [in] alignment The alignment needed.
+  * @return A pointer to the memory.
+  */
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+
+  /**
+  * @brief Does nothing, memory is reclaimed by release.
+  */
+  void do_deallocate(void* p, std::size_t bytes,
+                     std::size_t alignment) override;
+
+  /**
+  * @brief Arenas are only equal to themselves.
+  * @param [in] other Another memory resource.
+  * @return true, if other is this arena.
+  */
+  bool do_is_equal(const std::pmr::memory_resource& other)
+    const noexcept override;
+
+ private:
+  struct block {
+    char* begin;
+    std::size_t size;
+  };
+
+  std::vector<block> _blocks;
+  /**< The blocks by address, for owns. >**/
+  std::vector<block> _sorted;
+  char* _next;
+  char* _end;
+  std::size_t _blockSize;
+  std::size_t _bytesUsed;
+
+  /**
+  * @brief Get a new block from the heap and make it the current block.
+  * @param [in] size The size of the block.
+  */
+  void addBlock(std::size_t size);
+};
+
+#endif // CARD_ARENA_H_INCLUDED
@@ -0,0 +1,180 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <vector>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define CARD_BATCH_X86 1
+#endif
+
+#include "CardBatch.h"
+#include "BingoTypes.h"
+#include "WinPatterns.h"
+#include "Exceptions.h"
+
+namespace {
+
+const unsigned LANES = 8;
+const std::align_val_t MASK_ALIGNMENT{32};
+
+void scalarKernel(const std::uint32_t* masks, unsigned size,
+                  const unsigned* patterns, unsigned numPatterns,
+                  std::uint64_t* winners) {
+  for (unsigned i = 0; i < size; ++i) {
+    for (unsigned p = 0; p < numPatterns; ++p) {
+      if ((masks[i] & patterns[p]) == patterns[p]) {
+        winners[i / 64] |= std::uint64_t{1} << (i % 64);
+        break;
+      }
+    }
+  }
+}
+
+#ifdef CARD_BATCH_X86
+void sse2Kernel(const std::uint32_t* masks, unsigned size,
+                const unsigned* patterns, unsigned numPatterns,
+                std::uint64_t* winners) {
+  for (unsigned i = 0; i < size; i += 4) {
+    __m128i cards = _mm_load_si128(
+      reinterpret_cast<const __m128i*>(masks + i));
+    __m128i won = _mm_setzero_si128();
+    for (unsigned p = 0; p < numPatterns; ++p) {
+      __m128i pattern = _mm_set1_epi32(static_cast<int>(patterns[p]));
+      won = _mm_or_si128(won, _mm_cmpeq_epi32(_mm_and_si128(cards, pattern),
+                                              pattern));
+    }
+    std::uint64_t bits = _mm_movemask_ps(_mm_castsi128_ps(won));
+    winners[i / 64] |= bits << (i % 64);
+  }
+}
+
+__attribute__((target("avx2")))
+void avx2Kernel(const std::uint32_t* masks, unsigned size,
+                const unsigned* patterns, unsigned numPatterns,
+                std::uint64_t* winners) {
+  for (unsigned i = 0; i < size; i += 8) {
+    __m256i cards = _mm256_load_si256(
+      reinterpret_cast<const __m256i*>(masks + i));
+    __m256i won = _mm256_setzero_si256();
+    for (unsigned p = 0; p < numPatterns; ++p) {
+      __m256i pattern = _mm256_set1_epi32(static_cast<int>(patterns[p]));
+      won = _mm256_or_si256(won,
+        _mm256_cmpeq_epi32(_mm256_and_si256(cards, pattern), pattern));
+    }
+    std::uint64_t bits = _mm256_movemask_ps(_mm256_castsi256_ps(won));
+    winners[i / 64] |= bits << (i % 64);
+  }
+}
+#endif
+
+}  // namespace
+
+CardBatch::CardBatch(BingoTypes::victoryType victory)
+  : _masks{nullptr}, _size{0}, _capacity{0}, _victory{victory} {}
+
+CardBatch::~CardBatch() {
+  ::operator delete(_masks, MASK_ALIGNMENT);
+}
+
+unsigned CardBatch::getSize() {
+  return _size;
+}
+
+BingoTypes::victoryType CardBatch::getVictoryType() {
+  return _victory;
+}
+
+void CardBatch::setVictoryType(BingoTypes::victoryType victory) {
+  _victory = victory;
+}
+
+unsigned CardBatch::addCard(unsigned daubMask) {
+  if (_size == _capacity) {
+    reserve(std::max(2 * _capacity, LANES));
+  }
+  _masks[_size] = daubMask;
+  return _size++;
+}
+
+unsigned CardBatch::getDaubMask(unsigned index) {
+  if (index >= _size) {
+    throw bad_input("There is no card with this index in the batch.");
+  }
+  return _masks[index];
+}
+
+void CardBatch::setDaubMask(unsigned index, unsigned daubMask) {
+  if (index >= _size) {
+    throw bad_input("There is no card with this index in the batch.");
+  }
+  _masks[index] = daubMask;
+}
+
+void CardBatch::clear() {
+  if (_masks != nullptr) {
+    std::memset(_masks, 0, _capacity * sizeof(std::uint32_t));
+  }
+  _size = 0;
+}
+
+std::vector<std::uint64_t> CardBatch::findWinners() {
+  return findWinners(bestKernel());
+}
+
+std::vector<std::uint64_t> CardBatch::findWinners(kernelType kernel) {
+  std::vector<std::uint64_t> winners((_size + 63) / 64, 0);
+  if (_size == 0) {
+    return winners;
+  }
+
+  const WinPatterns::PatternSet& set = WinPatterns::patterns(_victory);
+  const unsigned* patterns = WinPatterns::MASKS.data() + set.first;
+  // The padding masks are empty so they never win, and LANES divides 64 so
+  // whole blocks of cards never write past the last word of winners.
+  unsigned blocks = (_size + LANES - 1) / LANES * LANES;
+
+  switch (kernel) {
+#ifdef CARD_BATCH_X86
+    case AVX2:
+      avx2Kernel(_masks, blocks, patterns, set.count, winners.data());
+      break;
+    case SSE2:
+      sse2Kernel(_masks, blocks, patterns, set.count, winners.data());
+      break;
+#endif
+    default:
+      scalarKernel(_masks, _size, patterns, set.count, winners.data());
+      break;
+  }
+
+  return winners;
+}
+
+CardBatch::kernelType CardBatch::bestKernel() {
+#ifdef CARD_BATCH_X86
+  static const kernelType best =
+    __builtin_cpu_supports("avx2") ? AVX2 : SSE2;
+  return best;
+#else
+  return SCALAR;
+#endif
+}
+
+void CardBatch::reserve(unsigned capacity) {
+  if (capacity <= _capacity) {
+    return;
+  }
+  capacity = (capacity + LANES - 1) / LANES * LANES;
+
+  std::uint32_t* masks = static_cast<std::uint32_t*>(
+    ::operator new(capacity * sizeof(std::uint32_t), MASK_ALIGNMENT));
+  std::memset(masks, 0, capacity * sizeof(std::uint32_t));
+  if (_masks != nullptr) {
+    std::memcpy(masks, _masks, _size * sizeof(std::uint32_t));
+    ::operator delete(_masks, MASK_ALIGNMENT);
+  }
+  _masks = masks;
+  _capacity = capacity;
+}
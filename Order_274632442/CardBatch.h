@@ -0,0 +1,126 @@
+#ifndef CARD_BATCH_H_INCLUDED
+#define CARD_BATCH_H_INCLUDED
+
+#include <cstdint>
+#include <vector>
+
+#include "BingoTypes.h"
+
+/**
+* @class CardBatch CardBatch.h "CardBatch.h"
+* @brief Stores the daub masks of many cards contiguously so they can be
+*   checked for victory several cards at a time.
+* @details The masks are kept in one 32 byte aligned array, padded with
+*   empty masks to a multiple of 8 cards. findWinners tests every pattern
+*   mask of the victory type against 8 (AVX2) or 4 (SSE2) cards per
+*   instruction, the kernel is chosen at run time from the CPU's features.
+*/
+class CardBatch {
+ public:
+  /**< The kernels that can evaluate a batch. >**/
+  enum kernelType {SCALAR, SSE2, AVX2};
+
+  /**
+  * @brief Default constructor.
+  * @param [in] victory The victoryType the cards are checked against.
+  */
+  CardBatch(BingoTypes::victoryType victory = BingoTypes::HORIZONTAL_LINE);
+
+  /**
+  * @brief Copy constructor, disabled.
+  * @param batch a CardBatch class object.
+  */
+  CardBatch(const CardBatch& batch) = delete;
+
+  /**
+  * @brief Assignment operator, disabled.
+  * @param batch a CardBatch class object.
+  */
+  void operator=(const CardBatch& batch) = delete;
+
+  /**
+  * @brief Destructor, deallocates the mask array.
+  */
+  virtual ~CardBatch();
+
+  /**
+  * @brief Access the number of cards in the batch.
+  * @return The number of cards.
+  */
+  unsigned getSize();
+
+  /**
+  * @brief Access the victoryType.
+  * @return The victory type.
+  */
+  BingoTypes::victoryType getVictoryType();
+
+  /**
+  * @brief Update the victory type.
+  * @param [in] victory A victoryType.
+  */
+  void setVictoryType(BingoTypes::victoryType victory);
+
+  /**
+  * @brief Add a card to the end of the batch.
+  * @param [in] daubMask The correct daub mask of the card,
+  *   see BingoCard::getDaubMask.
+  * @return The index of the card in the batch.
+  */
+  unsigned addCard(unsigned daubMask);
+
+  /**
+  * @brief Access the daub mask of a card.
+  * @param [in] index The index of the card.
+  * @return The daub mask of the card.
+  * @throw bad_input If index is not less than getSize.
+  */
+  unsigned getDaubMask(unsigned index);
+
+  /**
+  * @brief Update the daub mask of a card.
+  * @param [in] index The index of the card.
+  * @param [in] daubMask The correct daub mask of the card.
+  * @throw bad_input If index is not less than getSize.
+  */
+  void setDaubMask(unsigned index, unsigned daubMask);
+
+  /**
+  * @brief Remove all the cards, keeps the allocated array.
+  */
+  void clear();
+
+  /**
+  * @brief Determine which cards have met the victory condition.
+  * @details Uses the kernel given by bestKernel.
+  * @return A bitmap with bit (i % 64) of word (i / 64) set if card i has won.
+  */
+  std::vector<std::uint64_t> findWinners();
+
+  /**
+  * @brief Determine which cards have met the victory condition.
+  * @param [in] kernel The kernel to use, it must be supported by the CPU.
+  * @return A bitmap with bit (i % 64) of word (i / 64) set if card i has won.
+  */
+  std::vector<std::uint64_t> findWinners(kernelType kernel);
+
+  /**
+  * @brief The fastest kernel supported by the CPU running the program.
+  * @return The kernel type.
+  */
+  static kernelType bestKernel();
+
+ private:
+  std::uint32_t* _masks;
+  unsigned _size;
+  unsigned _capacity;
+  BingoTypes::victoryType _victory;
+
+  /**
+  * @brief Grow the mask array to hold at least capacity cards.
+  * @param [in] capacity The number of cards needed.
+  */
+  void reserve(unsigned capacity);
+};
+
+#endif // CARD_BATCH_H_INCLUDED
@@ -0,0 +1,219 @@
+
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+
+#include "ClueTable.h"
+#include "MappedFile.h"
+#include "Exceptions.h"
+
+namespace {
+
+/**
+* @brief A cursor over the text of a clues file that knows its line and
+*   column, for error messages.
+*/
+class ClueParser {
+ public:
+  ClueParser(std::string_view text, const std::string& name)
+    : _text{text}, _name{name}, _pos{0}, _line{1}, _lineStart{0} {}
+
+  std::size_t getPos() const {
+    return _pos;
+  }
+
+  bool atEnd() const {
+    return _pos == _text.size();
+  }
+
+  bool atLineEnd() const {
+    return atEnd() || _text[_pos] == '\n' || _text[_pos] == '\r';
+  }
+
+  [[noreturn]] void failAt(std::size_t pos, const std::string& what) const {
+    std::string message = _name + ":" + std::to_string(_line) + ":" +
+      std::to_string(pos - _lineStart + 1) + ": " + what;
+    throw bad_input(message.c_str());
+  }
+
+  [[noreturn]] void fail(const std::string& what) const {
+    failAt(_pos, what);
+  }
+
+  unsigned number(const char* what) {
+    const char* first = _text.data() + _pos;
+    unsigned value = 0;
+    std::from_chars_result result =
+      std::from_chars(first, _text.data() + _text.size(), value);
+    if (result.ec != std::errc{}) {
+      fail(what);
+    }
+    _pos += result.ptr - first;
+    return value;
+  }
+
+  void expect(char c, const char* what) {
+    if (atEnd() || _text[_pos] != c) {
+      fail(what);
+    }
+    ++_pos;
+  }
+
+  /**
+  * @brief Skip the field, up to the next comma or line end.
+  * @return The field.
+  */
+  std::string_view field() {
+    std::size_t end = _text.find_first_of(",\r\n", _pos);
+    if (end == std::string_view::npos) {
+      end = _text.size();
+    }
+    std::string_view result = _text.substr(_pos, end - _pos);
+    _pos = end;
+    return result;
+  }
+
+  /**
+  * @brief Move to the start of the next line, after an optional trailing
+  *   comma.
+  * @param [in] what The error message if the line has more in it.
+  */
+  void endLine(const char* what) {
+    if (!atEnd() && _text[_pos] == ',') {
+      ++_pos;
+    }
+    if (!atLineEnd()) {
+      fail(what);
+    }
+    if (!atEnd() && _text[_pos] == '\r') {
+      ++_pos;
+    }
+    if (!atEnd() && _text[_pos] == '\n') {
+      ++_pos;
+    }
+    ++_line;
+    _lineStart = _pos;
+  }
+
+  /**
+  * @brief Skip blank lines at the end of the text.
+  * @param [in] what The error message if there is more than blank lines.
+  */
+  void endText(const char* what) {
+    while (!atEnd()) {
+      if (!atLineEnd()) {
+        fail(what);
+      }
+      endLine(what);
+    }
+  }
+
+ private:
+  std::string_view _text;
+  const std::string& _name;
+  std::size_t _pos;
+  unsigned _line;
+  std::size_t _lineStart;
+};
+
+}  // namespace
+
+ClueTable::ClueTable()
+  : _offsets{nullptr}, _text{nullptr}, _numValues{0}, _numClues{0} {}
+
+ClueTable::ClueTable(const Pack& pack)
+  : _offsets{pack.offsets}, _text{pack.text}, _numValues{pack.numValues},
+    _numClues{pack.numClues} {}
+
+ClueTable ClueTable::embedded(std::string_view name, unsigned numValues) {
+  for (unsigned i = 0; i < NUM_PACKS; ++i) {
+    if (name == PACKS[i].name) {
+      if (PACKS[i].numValues != numValues) {
+        throw bad_input("The clue pack has the wrong number of values.");
+      }
+      return ClueTable(PACKS[i]);
+    }
+  }
+  throw bad_input("There is no clue pack with that name.");
+}
+
+ClueTable ClueTable::readFile(const std::string& cluesFile,
+                              unsigned numValues) {
+  MappedFile file(cluesFile, "clues");
+  return parse(file.getText(), cluesFile, numValues);
+}
+
+ClueTable ClueTable::parse(std::string_view text, const std::string& name,
+                           unsigned numValues) {
+  ClueParser parser(text, name);
+  if (text.size() >= std::numeric_limits<std::uint32_t>::max()) {
+    parser.fail("the clues file is too large");
+  }
+
+  std::size_t start = parser.getPos();
+  unsigned fileValues = parser.number("expected the number of values");
+  if (fileValues != numValues) {
+    parser.failAt(start, "the number of values must be " +
+                  std::to_string(numValues));
+  }
+  parser.expect(',', "expected a comma after the number of values");
+  start = parser.getPos();
+  unsigned numClues = parser.number("expected the number of clues");
+  if (numClues < 1 || numClues > MAX_CLUES) {
+    parser.failAt(start, "the number of clues must be between 1 and " +
+                  std::to_string(MAX_CLUES));
+  }
+  parser.endLine("expected the end of the first line");
+
+  // The clues are never longer than the rest of the text, so the offsets
+  // and the text fit one allocation made before the clues are read.
+  ClueTable table;
+  unsigned count = numValues * numClues;
+  std::size_t offsetsSize = (count + 1) * sizeof(std::uint32_t);
+  std::size_t textSize = text.size() - parser.getPos();
+  table._memory.reset(new char[offsetsSize + textSize]);
+  std::uint32_t* offsets = reinterpret_cast<std::uint32_t*>(
+    table._memory.get());
+  char* clueText = table._memory.get() + offsetsSize;
+
+  std::uint32_t length = 0;
+  for (unsigned value = 1; value <= numValues; ++value) {
+    if (parser.atEnd()) {
+      parser.fail("expected the line of clues for value " +
+                  std::to_string(value));
+    }
+    start = parser.getPos();
+    if (parser.number("expected a value at the start of the line") !=
+        value) {
+      parser.failAt(start, "expected the line of clues for value " +
+                    std::to_string(value));
+    }
+    for (unsigned clue = 0; clue < numClues; ++clue) {
+      std::string_view clueField;
+      if (!parser.atLineEnd()) {
+        parser.expect(',', "expected a comma before the next clue");
+        clueField = parser.field();
+      }
+      if (clueField.empty()) {
+        parser.fail("expected clue " + std::to_string(clue + 1) +
+                    " of value " + std::to_string(value));
+      }
+      *offsets++ = length;
+      std::memcpy(clueText + length, clueField.data(), clueField.size());
+      length += clueField.size();
+    }
+    parser.endLine("expected the end of the line after the last clue");
+  }
+  *offsets = length;
+  parser.endText("expected the end of the file after the last value");
+
+  table._offsets = reinterpret_cast<const std::uint32_t*>(
+    table._memory.get());
+  table._text = clueText;
+  table._numValues = numValues;
+  table._numClues = numClues;
+  return table;
+}
@@ -0,0 +1,157 @@
+
+#ifndef CLUE_TABLE_H_INCLUDED
+#define CLUE_TABLE_H_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+/**
+* @class ClueTable ClueTable.h "ClueTable.h"
+* @brief The clues for each value of a game, in one block of memory.
+* @details The text of all the clues is stored back to back, and an offset
+*   table indexed by (value, clue) marks where each one starts. The offsets
+*   and the text share a single allocation, so a table costs one new[] and
+*   looking up a clue is two loads. Tables of the embedded packs point into
+*   data compiled into the program and allocate nothing.
+*/
+class ClueTable {
+ public:
+  /**
+  * @brief A clues file compiled into the program.
+  * @details The packs are generated from the files in src/csv by
+  *   tools/EmbedClues.cpp into EmbeddedClues.cpp, and are constant
+  *   initialized, so using one does no I/O and no allocation.
+  */
+  struct Pack {
+    const char* name;
+    unsigned numValues;
+    unsigned numClues;
+    const std::uint32_t* offsets;
+    const char* text;
+  };
+
+  /**< The embedded packs, see EmbeddedClues.cpp. >**/
+  static const Pack PACKS[];
+  static const unsigned NUM_PACKS;
+
+  /**
+  * @brief Default constructor, a table with no clues.
+  */
+  ClueTable();
+
+  /**
+  * @brief Move constructor, the table takes over rv's memory.
+  * @param rv a ClueTable class object.
+  */
+  ClueTable(ClueTable&& rv) = default;
+
+  /**
+  * @brief Move assignment, the table takes over rv's memory.
+  * @param rv a ClueTable class object.
+  * @return This table.
+  */
+  ClueTable& operator=(ClueTable&& rv) = default;
+
+  /**
+  * @brief Copy constructor, disabled.
+  * @param rv a ClueTable class object.
+  */
+  ClueTable(const ClueTable& rv) = delete;
+
+  /**
+  * @brief Assignment operator, disabled.
+  * @param rv a ClueTable class object.
+  */
+  void operator=(const ClueTable& rv) = delete;
+
+  /**
+  * @brief Read a clues file.
+  * @details The file is mapped into memory and parsed in a single pass,
+  *   see parse for the format.
+  * @param [in] cluesFile The relative address of the clues file.
+  * @param [in] numValues The number of values the file must have.
+  * @return The clues of the file.
+  * @throw bad_input If the file cannot be opened or the format is
+  *   incorrect, the message gives the line and column of the problem.
+  */
+  static ClueTable readFile(const std::string& cluesFile,
+                            unsigned numValues);
+
+  /**
+  * @brief Parse the text of a clues file.
+  * @details The text is comma delimited. The first line holds the number
+  *   of values (must be numValues) and the number of clues for each value
+  *   (must be between 1 and MAX_CLUES). Each value then has a line of its
+  *   own, in order from 1, holding the value followed by its clues. Clues
+  *   cannot be empty, trailing commas and "\r\n" line ends are accepted.
+  * @param [in] text The text to parse.
+  * @param [in] name The name used for the text in error messages.
+  * @param [in] numValues The number of values the text must have.
+  * @return The clues of the text.
+  * @throw bad_input If the format is incorrect, the message gives the line
+  *   and column of the problem.
+  */
+  static ClueTable parse(std::string_view text, const std::string& name,
+                         unsigned numValues);
+
+  /**
+  * @brief Use an embedded pack.
+  * @param [in] name The name of the pack, the name of its clues file
+  *   without the extension, e.g. "bingo50calls".
+  * @param [in] numValues The number of values the pack must have.
+  * @return A table of the pack's clues, which allocates nothing.
+  * @throw bad_input If there is no such pack or it has the wrong number of
+  *   values.
+  */
+  static ClueTable embedded(std::string_view name, unsigned numValues);
+
+  /**
+  * @brief Access the number of values.
+  * @return The number of values with clues, 0 if the table is empty.
+  */
+  unsigned getNumValues() const {
+    return _numValues;
+  }
+
+  /**
+  * @brief Access the number of clues for each value.
+  * @return The number of clues for each value, 0 if the table is empty.
+  */
+  unsigned getNumClues() const {
+    return _numClues;
+  }
+
+  /**
+  * @brief Access a clue.
+  * @param [in] value The value, from 1 to getNumValues.
+  * @param [in] clue The clue of the value, from 0 to getNumClues - 1.
+  * @return The text of the clue, valid as long as the table.
+  */
+  std::string_view getClue(unsigned value, unsigned clue) const {
+    unsigned index = (value - 1) * _numClues + clue;
+    return std::string_view(_text + _offsets[index],
+                            _offsets[index + 1] - _offsets[index]);
+  }
+
+  /**< The most clues a value may have. >**/
+  static const unsigned MAX_CLUES = 10;
+
+ private:
+  /**
+  * @brief Constructor, for a table of an embedded pack.
+  * @param [in] pack The pack.
+  */
+  explicit ClueTable(const Pack& pack);
+
+  /**< Holds the offsets followed by the text, nullptr if not owned. >**/
+  std::unique_ptr<char[]> _memory;
+  const std::uint32_t* _offsets;
+  const char* _text;
+  unsigned _numValues;
+  unsigned _numClues;
+};
+
+#endif // CLUE_TABLE_H_INCLUDED
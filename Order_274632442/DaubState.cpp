@@ -9,6 +9,11 @@ NoDaub::NoDaub() {}
 
 NoDaub::~NoDaub() {}
 
+DaubState* NoDaub::getInstance() {
+  static NoDaub instance;
+  return &instance;
+}
+
 bool NoDaub::isDaubed() {
   return false;
 }
@@ -21,6 +26,11 @@ GoodDaub::GoodDaub() {}
 
 GoodDaub::~GoodDaub() {}
 
+DaubState* GoodDaub::getInstance() {
+  static GoodDaub instance;
+  return &instance;
+}
+
 bool GoodDaub::isDaubed() {
   return true;
 }
@@ -33,6 +43,11 @@ BadDaub::BadDaub() {}
 
 BadDaub::~BadDaub() {}
 
+DaubState* BadDaub::getInstance() {
+  static BadDaub instance;
+  return &instance;
+}
+
 bool BadDaub::isDaubed() {
   return true;
 }
@@ -45,6 +60,11 @@ NeedsDaub::NeedsDaub() {}
 
 NeedsDaub::~NeedsDaub() {}
 
+DaubState* NeedsDaub::getInstance() {
+  static NeedsDaub instance;
+  return &instance;
+}
+
 bool NeedsDaub::isDaubed() {
   return false;
 }
@@ -5,6 +5,9 @@
 /**
 * @class DaubState DaubState.h "DaubState.h"
 * @brief Interface for the possible outcomes of daubing a square.
+* @details The states carry no data, so each subclass provides one shared,
+*   immutable instance through getInstance. Squares point at these
+*   instances without owning them, so daubing never allocates.
 */
 class DaubState {
  public:
@@ -47,6 +50,12 @@ class NoDaub : public DaubState {
   */
   virtual ~NoDaub();
 
+  /**
+  * @brief Access the state shared by all squares in this state.
+  * @return A pointer to the shared NoDaub, it must not be deleted.
+  */
+  static DaubState* getInstance();
+
   /**
    * @brief In this state the square has not been daubed.
    * @return false.
@@ -76,6 +85,12 @@ class GoodDaub : public DaubState {
   */
   virtual ~GoodDaub();
 
+  /**
+  * @brief Access the state shared by all squares in this state.
+  * @return A pointer to the shared GoodDaub, it must not be deleted.
+  */
+  static DaubState* getInstance();
+
   /**
    * @brief In this state the square has been daubed.
    * @return true.
@@ -106,6 +121,12 @@ class BadDaub : public DaubState {
   */
   virtual ~BadDaub();
 
+  /**
+  * @brief Access the state shared by all squares in this state.
+  * @return A pointer to the shared BadDaub, it must not be deleted.
+  */
+  static DaubState* getInstance();
+
   /**
    * @brief In this state the square has been daubed.
    * @return true.
@@ -135,6 +156,12 @@ class NeedsDaub : public DaubState {
   */
   virtual ~NeedsDaub();
 
+  /**
+  * @brief Access the state shared by all squares in this state.
+  * @return A pointer to the shared NeedsDaub, it must not be deleted.
+  */
+  static DaubState* getInstance();
+
   /**
    * @brief In this state the square has not been daubed.
    * @return false.
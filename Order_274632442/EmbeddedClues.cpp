@@ -0,0 +1,155 @@
+// Generated by tools/EmbedClues.cpp, do not edit.
+
+#include <cstdint>
+
+#include "ClueTable.h"
+
+namespace {
+
+constexpr std::uint32_t BINGO50CALLS_OFFSETS[] = {
+  0, 7, 14, 21, 28, 35, 43, 50, 57, 64,
+  71, 78, 85, 92, 101, 108, 116, 123, 131, 138,
+  146, 153, 161, 168, 177, 184, 191, 198, 206, 213,
+  222, 229, 238, 245, 253, 260, 268, 275, 283, 290,
+  298, 306, 316, 323, 331, 338, 346, 354, 362, 370,
+  378, 385, 393, 400, 408, 416, 425, 432, 440, 448,
+  456, 463, 471, 479, 487, 495, 503, 511, 519, 527,
+  535, 543, 551, 559, 569, 577, 585, 593, 601, 609,
+  617, 625, 634, 642, 650, 658, 666, 674, 682, 690,
+  700, 708, 716, 724, 732, 740, 748, 755, 763, 771,
+  780, 788, 797, 806, 814, 821, 829, 837, 845, 853,
+  862, 870, 878, 886, 896, 905, 913, 921, 929, 937,
+  945, 953, 961, 970, 978, 986, 994, 1003, 1012, 1020,
+  1029, 1038, 1046, 1054, 1063, 1071, 1080, 1087, 1096, 1105,
+  1113, 1121, 1130, 1139, 1147, 1155, 1163, 1172, 1180, 1188,
+  1196, 1205, 1213, 1221, 1230, 1238, 1246, 1253, 1262, 1270,
+  1278, 1286, 1296, 1305, 1314, 1322, 1331, 1339, 1347, 1355,
+  1365, 1374, 1382, 1390, 1399, 1408, 1416, 1423, 1433, 1441,
+  1449, 1457, 1465, 1473, 1481, 1489, 1497, 1505, 1513, 1521,
+  1530, 1539, 1547, 1554, 1563, 1572, 1580, 1588, 1597, 1606,
+  1615,
+};
+
+constexpr char BINGO50CALLS_TEXT[] =
+  "B:1 x 1B:1 / 1B:0 + 1B:6 - 5"
+  "B:2 x 1B:14 / 7B:1 + 1B:4 - 2"
+  "B:3 x 1B:9 / 3B:3 + 0B:4 - 1"
+  "B:1 x 4B:40 / 10B:3 + 1B:12 - 8"
+  "B:1 x 5B:10 / 2B:1 + 4B:11 - 6"
+  "B:2 x 3B:18 / 3B:4 + 2B:17 - 11"
+  "B:7 x 1B:7 / 1B:5 + 2B:11 - 4"
+  "B:8 x 1B:88 / 11B:6 + 2B:19 - 11"
+  "B:3 x 3B:27 / 3B:6 + 3B:10 - 1"
+  "B:5 x 2B:20 / 2B:4 + 6B:15 - 5"
+  "I:11 x 1I:121 / 11I:8 + 3I:12 - 1"
+  "I:6 x 2I:84 / 7I:2 + 10I:15 - 3"
+  "I:13 x 1I:65 / 5I:4 + 9I:19 - 6"
+  "I:7 x 2I:70 / 5I:1 + 13I:24 - 10"
+  "I:5 x 3I:60 / 4I:3 + 12I:20 - 5"
+  "I:2 x 8I:64 / 4I:0 + 16I:18 - 2"
+  "I:17 x 1I:68 / 4I:17 + 0I:18 - 1"
+  "I:18 x 1I:90 / 5I:5 + 13I:20 - 2"
+  "I:19 x 1I:190 / 10I:3 + 16I:23 - 4"
+  "I:20 x 1I:40 / 2I:1 + 19I:22 - 2"
+  "N:21 x 1N:105 / 5N:18 + 3N:23 - 2"
+  "N:11 x 2N:88 / 4N:22 + 0N:28 - 6"
+  "N:23 x 1N:230 / 10N:16 + 7N:25 - 2"
+  "N:12 x 2N:72 / 3N:23 + 1N:30 - 6"
+  "N:5 x 5N:50 / 2N:3 + 22N:37 - 12"
+  "N:26 x 1N:130 / 5N:12 + 14N:33 - 7"
+  "N:9 x 3N:54 / 2N:0 + 27N:29 - 2"
+  "N:14 x 2N:140 / 5N:22 + 6N:29 - 1"
+  "N:29 x 1N:290 / 10N:16 + 13N:33 - 4"
+  "N:30 x 1N:90 / 3N:29 + 1N:31 - 1"
+  "G:31 x 1G:93 / 3G:15 + 16G:40 - 9"
+  "G:16 x 2G:96 / 3G:14 + 18G:43 - 11"
+  "G:3 x 11G:165 / 5G:14 + 19G:36 - 3"
+  "G:17 x 2G:102 / 3G:3 + 31G:45 - 11"
+  "G:5 x 7G:140 / 4G:17 + 18G:40 - 5"
+  "G:18 x 2G:180 / 5G:24 + 12G:43 - 7"
+  "G:37 x 1G:74 / 2G:18 + 19G:39 - 2"
+  "G:19 x 2G:76 / 2G:27 + 11G:40 - 2"
+  "G:39 x 1G:117 / 3G:31 + 8G:47 - 8"
+  "G:5 x 8G:120 / 3G:32 + 8G:44 - 4"
+  "O:41 x 1O:410 / 10O:18 + 23O:51 - 10"
+  "O:42 x 1O:168 / 4O:36 + 6O:48 - 6"
+  "O:43 x 1O:430 / 10O:15 + 28O:44 - 1"
+  "O:4 x 11O:176 / 4O:18 + 26O:47 - 3"
+  "O:5 x 9O:450 / 10O:43 + 2O:49 - 4"
+  "O:23 x 2O:92 / 2O:1 + 45O:53 - 7"
+  "O:47 x 1O:94 / 2O:3 + 44O:53 - 6"
+  "O:16 x 3O:144 / 3O:16 + 32O:57 - 9"
+  "O:7 x 7O:147 / 3O:39 + 10O:54 - 5"
+  "O:25 x 2O:200 / 4O:25 + 25O:62 - 12";
+
+constexpr std::uint32_t BINGO50CLUES_OFFSETS[] = {
+  0, 3, 6, 9, 12, 15, 18, 21, 24, 27,
+  31, 35, 39, 43, 47, 51, 55, 59, 63, 67,
+  71, 75, 79, 83, 87, 91, 95, 99, 103, 107,
+  111, 115, 119, 123, 127, 131, 135, 139, 143, 147,
+  151, 155, 159, 163, 167, 171, 175, 179, 183, 187,
+  191,
+};
+
+constexpr char BINGO50CLUES_TEXT[] =
+  "B:1"
+  "B:2"
+  "B:3"
+  "B:4"
+  "B:5"
+  "B:6"
+  "B:7"
+  "B:8"
+  "B:9"
+  "B:10"
+  "I:11"
+  "I:12"
+  "I:13"
+  "I:14"
+  "I:15"
+  "I:16"
+  "I:17"
+  "I:18"
+  "I:19"
+  "I:20"
+  "N:21"
+  "N:22"
+  "N:23"
+  "N:24"
+  "N:25"
+  "N:26"
+  "N:27"
+  "N:28"
+  "N:29"
+  "N:30"
+  "G:31"
+  "G:32"
+  "G:33"
+  "G:34"
+  "G:35"
+  "G:36"
+  "G:37"
+  "G:38"
+  "G:39"
+  "G:40"
+  "O:41"
+  "O:42"
+  "O:43"
+  "O:44"
+  "O:45"
+  "O:46"
+  "O:47"
+  "O:48"
+  "O:49"
+  "O:50";
+
+}  // namespace
+
+const ClueTable::Pack ClueTable::PACKS[] = {
+  {"bingo50calls", 50, 4,
+   BINGO50CALLS_OFFSETS, BINGO50CALLS_TEXT},
+  {"bingo50clues", 50, 1,
+   BINGO50CLUES_OFFSETS, BINGO50CLUES_TEXT},
+};
+
+const unsigned ClueTable::NUM_PACKS = 2;
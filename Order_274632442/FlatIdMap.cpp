@@ -0,0 +1,196 @@
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "FlatIdMap.h"
+#include "Exceptions.h"
+
+FlatIdMap::FlatIdMap()
+  : _table{nullptr}, _numEntries{0}, _size{0}, _used{0}, _idBytes{0} {}
+
+FlatIdMap::FlatIdMap(FlatIdMap&& other) : FlatIdMap() {
+  *this = std::move(other);
+}
+
+FlatIdMap& FlatIdMap::operator=(FlatIdMap&& other) {
+  if (this != &other) {
+    // A short _ids is inside the string, so _idText is set again.
+    bool ownIds = other._idText.data() == other._ids.data();
+    _table = other._table;
+    _numEntries = other._numEntries;
+    _entries = std::move(other._entries);
+    _ids = std::move(other._ids);
+    _idText = ownIds ? std::string_view(_ids) : other._idText;
+    _size = other._size;
+    _used = other._used;
+    _idBytes = other._idBytes;
+    other._table = nullptr;
+    other._numEntries = 0;
+    other._entries.clear();
+    other._ids.clear();
+    other.clear();
+  }
+  return *this;
+}
+
+unsigned FlatIdMap::find(std::string_view id) const {
+  if (_size == 0) {
+    return NOT_FOUND;
+  }
+  const entry& e = _table[probe(id, std::hash<std::string_view>{}(id))];
+  return e.state == FULL ? e.value : NOT_FOUND;
+}
+
+bool FlatIdMap::insert(std::string_view id, unsigned value) {
+  // Keep at most 7/8 of the entries in use so probes stay short, and at
+  // most half the ids erased.
+  if ((_used + 1) * 8 > _numEntries * 7
+      || _idText.size() > 2 * _idBytes + 1024) {
+    rehash(_size + 1);
+  }
+  std::size_t hash = std::hash<std::string_view>{}(id);
+  std::size_t mask = _numEntries - 1;
+  std::size_t reuse = _numEntries;
+  for (std::size_t i = hash & mask; ; i = (i + 1) & mask) {
+    entry& e = _table[i];
+    if (e.state == EMPTY) {
+      if (reuse == _numEntries) {
+        reuse = i;
+        ++_used;
+      }
+      break;
+    }
+    if (e.state == ERASED) {
+      if (reuse == _numEntries) {
+        reuse = i;
+      }
+    } else if (e.hash == hash && idOf(e) == id) {
+      return false;
+    }
+  }
+  if (_idText.data() != _ids.data()) {
+    _ids.assign(_idText.data(), _idText.size());  // the restored ids
+  }
+  entry& e = _table[reuse];
+  e.hash = hash;
+  e.value = value;
+  e.idOffset = _ids.size();
+  e.idSize = id.size();
+  e.state = FULL;
+  _ids.append(id.data(), id.size());
+  _idText = _ids;
+  _idBytes += id.size();
+  ++_size;
+  return true;
+}
+
+bool FlatIdMap::erase(std::string_view id) {
+  if (_size == 0) {
+    return false;
+  }
+  entry& e = _table[probe(id, std::hash<std::string_view>{}(id))];
+  if (e.state != FULL) {
+    return false;
+  }
+  e.state = ERASED;
+  _idBytes -= e.idSize;
+  --_size;
+  return true;
+}
+
+void FlatIdMap::clear() {
+  if (_table != _entries.data()) {
+    _table = nullptr;  // let go of a restored table
+    _numEntries = 0;
+  }
+  for (entry& e : _entries) {
+    e.state = EMPTY;
+  }
+  _ids.clear();
+  _idText = _ids;
+  _size = 0;
+  _used = 0;
+  _idBytes = 0;
+}
+
+void FlatIdMap::restore(entry* entries, std::size_t numEntries,
+                        std::string_view ids) {
+  if ((numEntries & (numEntries - 1)) != 0) {
+    throw bad_input("The saved ids are not a table.");
+  }
+  unsigned size = 0;
+  unsigned used = 0;
+  std::size_t idBytes = 0;
+  for (std::size_t i = 0; i < numEntries; ++i) {
+    const entry& e = entries[i];
+    if (e.state == EMPTY) {
+      continue;
+    }
+    if (e.state > ERASED || e.idOffset > ids.size()
+        || e.idSize > ids.size() - e.idOffset) {
+      throw bad_input("The saved ids are not a table.");
+    }
+    ++used;
+    if (e.state == FULL) {
+      ++size;
+      idBytes += e.idSize;
+    }
+  }
+  if (numEntries != 0 && used * std::size_t{8} > numEntries * 7) {
+    throw bad_input("The saved ids are not a table.");
+  }
+  _table = entries;
+  _numEntries = numEntries;
+  _entries.clear();
+  _idText = ids;
+  _ids.clear();
+  _size = size;
+  _used = used;
+  _idBytes = idBytes;
+}
+
+std::size_t FlatIdMap::probe(std::string_view id, std::size_t hash) const {
+  std::size_t mask = _numEntries - 1;
+  for (std::size_t i = hash & mask; ; i = (i + 1) & mask) {
+    const entry& e = _table[i];
+    if (e.state == EMPTY ||
+        (e.state == FULL && e.hash == hash && idOf(e) == id)) {
+      return i;
+    }
+  }
+}
+
+void FlatIdMap::rehash(unsigned count) {
+  std::size_t capacity = _numEntries == 0 ? 16 : _numEntries;
+  while (std::size_t{count} * 2 > capacity) {
+    capacity *= 2;
+  }
+  std::vector<entry> entries(capacity, entry{0, 0, 0, 0, EMPTY});
+  std::string ids;
+  ids.reserve(_idBytes);
+  std::size_t mask = capacity - 1;
+  for (std::size_t j = 0; j < _numEntries; ++j) {
+    const entry& e = _table[j];
+    if (e.state != FULL) {
+      continue;
+    }
+    std::size_t i = e.hash & mask;
+    while (entries[i].state != EMPTY) {
+      i = (i + 1) & mask;
+    }
+    entry& moved = entries[i];
+    moved = e;
+    moved.idOffset = ids.size();
+    ids.append(_idText.data() + e.idOffset, e.idSize);
+  }
+  _entries.swap(entries);
+  _table = _entries.data();
+  _numEntries = capacity;
+  _ids.swap(ids);
+  _idText = _ids;
+  _used = _size;
+}
@@ -0,0 +1,184 @@
+
+#ifndef FLAT_ID_MAP_H_INCLUDED
+#define FLAT_ID_MAP_H_INCLUDED
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+* @class FlatIdMap FlatIdMap.h "FlatIdMap.h"
+* @brief An open addressing hash map from string ids to unsigned values.
+* @details The entries live in one vector and collisions probe the next
+*   entry, so a lookup hashes the id once and usually reads one or two
+*   neighbouring entries. Each entry keeps the full hash of its id, and ids
+*   are only compared when the hashes match. The ids are kept one after the
+*   other in one string, so the entries are plain bytes and a whole table
+*   can be saved and loaded as is, and a loaded table is used where it
+*   lies. Erased entries are marked and reused, the table is rebuilt when
+*   they or the ids they leave behind pile up.
+*/
+class FlatIdMap {
+ public:
+  /**< The value find returns for an id that is not in the map. >**/
+  static const unsigned NOT_FOUND = ~0u;
+
+  enum entryState : unsigned char {EMPTY, FULL, ERASED};
+
+  /**
+  * @brief An entry of the table.
+  */
+  struct entry {
+    std::size_t hash;
+    unsigned value;
+    /**< The id is the idSize characters at idOffset in the ids. >**/
+    unsigned idOffset;
+    unsigned idSize;
+    entryState state;
+  };
+
+  /**
+  * @brief Default constructor, no memory is allocated until an insert.
+  */
+  FlatIdMap();
+
+  /**
+  * @brief Copy constructor, disabled, the table may not be the map's own.
+  * @param rv a FlatIdMap class object.
+  */
+  FlatIdMap(const FlatIdMap& rv) = delete;
+
+  /**
+  * @brief Assignment operator, disabled.
+  * @param rv a FlatIdMap class object.
+  */
+  void operator=(const FlatIdMap& rv) = delete;
+
+  /**
+  * @brief Move constructor, the table and ids move with the map.
+  * @param [in] other The map to move, it is left empty.
+  */
+  FlatIdMap(FlatIdMap&& other);
+
+  /**
+  * @brief Move assignment operator, the table and ids move with the map.
+  * @param [in] other The map to move, it is left empty.
+  * @return This map.
+  */
+  FlatIdMap& operator=(FlatIdMap&& other);
+
+  /**
+  * @brief Look up an id.
+  * @param [in] id The id.
+  * @return The value of id, NOT_FOUND if id is not in the map.
+  */
+  unsigned find(std::string_view id) const;
+
+  /**
+  * @brief Add an id.
+  * @param [in] id The id.
+  * @param [in] value The value of id, not NOT_FOUND.
+  * @return true, if id is added, false if it is already in the map.
+  */
+  bool insert(std::string_view id, unsigned value);
+
+  /**
+  * @brief Remove an id.
+  * @param [in] id The id.
+  * @return true, if id was in the map, false otherwise.
+  */
+  bool erase(std::string_view id);
+
+  /**
+  * @brief Remove every id, the memory is kept unless the table is loaded.
+  */
+  void clear();
+
+  /**
+  * @brief Access the number of ids.
+  * @return The number of ids in the map.
+  */
+  unsigned size() const {
+    return _size;
+  }
+
+  /**
+  * @brief Access the table, e.g. to save it.
+  * @return The first of getNumEntries entries.
+  */
+  const entry* getEntries() const {
+    return _table;
+  }
+
+  /**
+  * @brief Access the size of the table.
+  * @return The number of entries, 0 or a power of two.
+  */
+  std::size_t getNumEntries() const {
+    return _numEntries;
+  }
+
+  /**
+  * @brief Access the ids of the table, e.g. to save them.
+  * @return The characters the entries' ids are in.
+  */
+  std::string_view getIds() const {
+    return _idText;
+  }
+
+  /**
+  * @brief Replace the map with a saved table, which is used in place.
+  * @details Nothing is copied: the map changes the entries where they are
+  *   until it outgrows them, and reads the ids where they are until an id
+  *   is added. So both must stay valid until the map is cleared, restored
+  *   or destroyed.
+  * @param [in] entries The entries of getEntries.
+  * @param [in] numEntries The number of entries.
+  * @param [in] ids The ids of getIds.
+  * @throw bad_input If the entries are not a table or don't fit the ids.
+  */
+  void restore(entry* entries, std::size_t numEntries, std::string_view ids);
+
+ private:
+  /**< The table, _entries unless a saved table is restored. >**/
+  entry* _table;
+  std::size_t _numEntries;
+  std::vector<entry> _entries;
+  /**< The ids of the FULL entries, and of ERASED ones until a rehash. Either
+   _ids or the ids of a restored table. >**/
+  std::string_view _idText;
+  std::string _ids;
+  /**< The number of FULL entries. >**/
+  unsigned _size;
+  /**< The number of FULL and ERASED entries. >**/
+  unsigned _used;
+  /**< The length of the ids of the FULL entries. >**/
+  std::size_t _idBytes;
+
+  /**
+  * @brief Access the id of an entry.
+  * @param [in] e An entry that is not EMPTY.
+  * @return The id.
+  */
+  std::string_view idOf(const entry& e) const {
+    return _idText.substr(e.idOffset, e.idSize);
+  }
+
+  /**
+  * @brief The entry holding id, or the first EMPTY entry on its probe.
+  * @param [in] id The id.
+  * @param [in] hash The hash of id.
+  * @return The index of the entry.
+  */
+  std::size_t probe(std::string_view id, std::size_t hash) const;
+
+  /**
+  * @brief Rebuild the table with room for more ids, dropping the ERASED
+  *   entries and their ids.
+  * @param [in] count The number of ids to make room for.
+  */
+  void rehash(unsigned count);
+};
+
+#endif // FLAT_ID_MAP_H_INCLUDED
@@ -0,0 +1,296 @@
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "GameJournal.h"
+#include "BingoCard.h"
+#include "MappedFile.h"
+#include "WinPatterns.h"
+#include "Exceptions.h"
+
+namespace {
+
+const char JOURNAL_MAGIC[] = "BINGOJNL";
+const std::uint32_t JOURNAL_VERSION = 1;
+
+static_assert(sizeof(GameJournal::event) == 64,
+              "an event is 64 bytes with no padding");
+static_assert(std::is_trivially_copyable<GameJournal::event>::value,
+              "events are written and read as bytes");
+
+/**
+* @brief The tables of the CRC-32C, the Castagnoli polynomial reflected,
+*   for eight bytes at a time: table k advances a byte by k more bytes.
+*/
+typedef std::array<std::array<std::uint32_t, 256>, 8> crcTables;
+
+crcTables makeCrcTables() {
+  crcTables tables{};
+  for (std::uint32_t i = 0; i < 256; ++i) {
+    std::uint32_t crc = i;
+    for (unsigned bit = 0; bit < 8; ++bit) {
+      crc = (crc >> 1) ^ (0x82f63b78u & (0u - (crc & 1)));
+    }
+    tables[0][i] = crc;
+  }
+  for (unsigned k = 1; k < tables.size(); ++k) {
+    for (std::uint32_t i = 0; i < 256; ++i) {
+      std::uint32_t crc = tables[k - 1][i];
+      tables[k][i] = (crc >> 8) ^ tables[0][crc & 0xff];
+    }
+  }
+  return tables;
+}
+
+const crcTables CRC_TABLES = makeCrcTables();
+
+/**
+* @brief Read four bytes as a little endian number.
+*/
+std::uint32_t littleEndian(const unsigned char* bytes) {
+  return bytes[0] | std::uint32_t{bytes[1]} << 8
+    | std::uint32_t{bytes[2]} << 16 | std::uint32_t{bytes[3]} << 24;
+}
+
+/**
+* @brief The checksum of an event.
+* @details Replay checks every event, so eight bytes are taken at a time,
+*   which is several times faster than a byte at a time.
+* @param [in] e The event.
+* @return The CRC-32C of the bytes after the checksum.
+*/
+std::uint32_t checksumOf(const GameJournal::event& e) {
+  const crcTables& t = CRC_TABLES;
+  const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&e);
+  std::size_t i = sizeof(e.checksum);
+  std::uint32_t crc = ~0u;
+  for (; i + 8 <= sizeof(e); i += 8) {
+    std::uint32_t low = littleEndian(bytes + i) ^ crc;
+    std::uint32_t high = littleEndian(bytes + i + 4);
+    crc = t[7][low & 0xff] ^ t[6][(low >> 8) & 0xff]
+      ^ t[5][(low >> 16) & 0xff] ^ t[4][low >> 24]
+      ^ t[3][high & 0xff] ^ t[2][(high >> 8) & 0xff]
+      ^ t[1][(high >> 16) & 0xff] ^ t[0][high >> 24];
+  }
+  for (; i < sizeof(e); ++i) {
+    crc = t[0][(crc ^ bytes[i]) & 0xff] ^ (crc >> 8);
+  }
+  return ~crc;
+}
+
+/**
+* @brief Write all of a buffer.
+* @param [in] fd The file.
+* @param [in] data The bytes.
+* @param [in] size The number of bytes.
+* @return true, if every byte is written, false otherwise.
+*/
+bool writeAll(int fd, const char* data, std::size_t size) {
+  while (size > 0) {
+    ssize_t written = ::write(fd, data, size);
+    if (written < 0 && errno == EINTR) {
+      continue;
+    }
+    if (written <= 0) {
+      return false;
+    }
+    data += written;
+    size -= written;
+  }
+  return true;
+}
+
+}  // namespace
+
+GameJournal::GameJournal(const std::string& fileName,
+                         BingoTypes::gameType game, unsigned batchSize)
+  : _fileName{fileName}, _fd{-1}, _sequence{0},
+    _batchSize{batchSize == 0 ? 1 : batchSize} {
+  // Read an existing journal before the file is opened to be written.
+  struct stat info;
+  if (::stat(fileName.c_str(), &info) == 0 && info.st_size > 0) {
+    MappedFile file(fileName, "journal");
+    _sequence = readEvents(file.getText(), game, fileName).size() + 1;
+  }
+
+  _fd = ::open(fileName.c_str(), O_WRONLY | O_CREAT, 0644);
+  if (_fd < 0) {
+    throw bad_input(("Could not open the journal file " + fileName +
+                     ".").c_str());
+  }
+  bool ok;
+  if (_sequence == 0) {
+    event start{};
+    start.sequence = _sequence++;
+    start.player = game;
+    start.type = JOURNAL_START;
+    start.size = JOURNAL_VERSION;
+    std::memcpy(start.data, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC) - 1);
+    start.checksum = checksumOf(start);
+    ok = writeAll(_fd, reinterpret_cast<const char*>(&start), sizeof(start))
+      && ::fsync(_fd) == 0;
+  } else {
+    // Cut off a torn or damaged tail, the next event goes in its place.
+    off_t end = static_cast<off_t>(_sequence) * sizeof(event);
+    ok = ::ftruncate(_fd, end) == 0 && ::lseek(_fd, end, SEEK_SET) == end;
+  }
+  if (!ok) {
+    ::close(_fd);
+    throw bad_input(("Could not write the journal file " + fileName +
+                     ".").c_str());
+  }
+  _pending.reserve(_batchSize);
+}
+
+GameJournal::~GameJournal() {
+  if (writeBatch()) {
+    ::fsync(_fd);
+  }
+  ::close(_fd);
+}
+
+void GameJournal::ballPulled(unsigned ball, bool autoDaub) {
+  event& e = append(BALL_PULLED, 0);
+  e.ball = ball;
+  e.flag = autoDaub;
+}
+
+void GameJournal::squareDaubed(unsigned player, unsigned ball,
+                               unsigned location) {
+  event& e = append(SQUARE_DAUBED, player);
+  e.ball = ball;
+  e.location = location;
+}
+
+void GameJournal::bingoClaimed(unsigned player, bool met) {
+  event& e = append(BINGO_CLAIMED, player);
+  e.flag = met;
+}
+
+void GameJournal::playerJoined(unsigned player, std::string_view id,
+                               BingoCard* card) {
+  event& e = append(PLAYER_JOINED, player, 1 + numIdParts(id.size()));
+  e.flag = card->getVictoryType();
+  e.size = id.size();
+  for (unsigned row = 1; row <= WinPatterns::NUM_ROWS; ++row) {
+    for (unsigned col = 1; col <= WinPatterns::NUM_COLS; ++col) {
+      e.data[WinPatterns::location(row - 1, col - 1)] =
+        card->getSquare({row, col})->getValue();
+    }
+  }
+  std::string_view part = id.substr(0, JOIN_ID_BYTES);
+  std::memcpy(e.data + WinPatterns::NUM_SQUARES, part.data(), part.size());
+  for (id.remove_prefix(part.size()); !id.empty();
+       id.remove_prefix(part.size())) {
+    part = id.substr(0, PART_ID_BYTES);
+    std::memcpy(add(ID_PART, player).data, part.data(), part.size());
+  }
+}
+
+void GameJournal::playerLeft(unsigned player) {
+  append(PLAYER_LEFT, player);
+}
+
+void GameJournal::gameReset() {
+  append(GAME_RESET, 0);
+}
+
+void GameJournal::gameSettings(BingoTypes::victoryType victory,
+                               bool autoDaub) {
+  event& e = append(GAME_SETTINGS, 0);
+  e.flag = victory;
+  e.size = autoDaub;
+}
+
+void GameJournal::commit() {
+  if (!writeBatch() || ::fsync(_fd) != 0) {
+    throw bad_input(("Could not write the journal file " + _fileName +
+                     ".").c_str());
+  }
+}
+
+GameJournal::eventList GameJournal::readEvents(std::string_view text,
+                                               BingoTypes::gameType game,
+                                               const std::string& fileName) {
+  const event* events = reinterpret_cast<const event*>(text.data());
+  if (text.size() < sizeof(event)
+      || events[0].checksum != checksumOf(events[0])
+      || events[0].type != JOURNAL_START
+      || events[0].size != JOURNAL_VERSION
+      || std::memcmp(events[0].data, JOURNAL_MAGIC,
+                     sizeof(JOURNAL_MAGIC) - 1) != 0) {
+    throw bad_input(("The file " + fileName +
+                     " is not a journal of this version.").c_str());
+  }
+  if (events[0].player != static_cast<std::uint32_t>(game)) {
+    throw card_to_game_mismatch("The journal is of another game type.");
+  }
+
+  std::size_t count = text.size() / sizeof(event);
+  std::size_t end = 1;
+  while (end < count && events[end].sequence == end
+         && events[end].checksum == checksumOf(events[end])) {
+    ++end;
+  }
+  // A join is whole only with all of its parts.
+  std::size_t lastPart = end;
+  while (lastPart > 1 && events[lastPart - 1].type == ID_PART) {
+    --lastPart;
+  }
+  if (lastPart > 1 && events[lastPart - 1].type == PLAYER_JOINED
+      && numIdParts(events[lastPart - 1].size) > end - lastPart) {
+    end = lastPart - 1;
+  }
+  return {events + 1, end - 1};
+}
+
+GameJournal::event& GameJournal::append(eventType type, unsigned player,
+                                        std::size_t numEvents) {
+  if (!_pending.empty() && _pending.size() + numEvents > _batchSize
+      && !writeBatch()) {
+    throw bad_input(("Could not write the journal file " + _fileName +
+                     ".").c_str());
+  }
+  return add(type, player);
+}
+
+GameJournal::event& GameJournal::add(eventType type, unsigned player) {
+  _pending.push_back(event{});
+  event& e = _pending.back();
+  e.sequence = _sequence++;
+  e.player = player;
+  e.type = type;
+  return e;
+}
+
+bool GameJournal::writeBatch() {
+  if (_pending.empty()) {
+    return true;
+  }
+  for (event& e : _pending) {
+    e.checksum = checksumOf(e);
+  }
+  // A batch is written whole or not at all, so a retry doesn't leave a
+  // half batch in front of it.
+  off_t start = ::lseek(_fd, 0, SEEK_CUR);
+  if (!writeAll(_fd, reinterpret_cast<const char*>(_pending.data()),
+                _pending.size() * sizeof(event))) {
+    if (start >= 0 && ::ftruncate(_fd, start) == 0) {
+      ::lseek(_fd, start, SEEK_SET);
+    }
+    return false;
+  }
+  _pending.clear();
+  return true;
+}
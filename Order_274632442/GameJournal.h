@@ -0,0 +1,242 @@
+
+#ifndef GAME_JOURNAL_H_INCLUDED
+#define GAME_JOURNAL_H_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "BingoCard.h"
+#include "BingoTypes.h"
+#include "WinPatterns.h"
+
+/**
+* @class GameJournal GameJournal.h "GameJournal.h"
+* @brief An append only file of every change to one BingoGame.
+* @details Each change is one fixed size event with a checksum and its
+*   place in the journal, except a join, whose id continues in ID_PART
+*   events when it is long, written in the same batch as the join. Events
+*   are kept in memory and written in batches, and commit writes what is
+*   left and syncs the file, so the sync is paid once per group of moves
+*   and never by a move itself. An event that was not committed can be
+*   lost in a crash, a torn write is found by its checksum and the journal
+*   ends before it, or before its join.
+*/
+class GameJournal {
+ public:
+  enum eventType : std::uint8_t {JOURNAL_START, BALL_PULLED, SQUARE_DAUBED,
+    BINGO_CLAIMED, PLAYER_JOINED, ID_PART, PLAYER_LEFT, GAME_RESET,
+    GAME_SETTINGS};
+
+  /**
+  * @brief One change, 64 bytes.
+  */
+  struct event {
+    /**< The CRC-32C of the rest of the event. >**/
+    std::uint32_t checksum;
+    /**< The place of the event in the journal, JOURNAL_START is 0. >**/
+    std::uint32_t sequence;
+    /**< The player's handle, the game type for JOURNAL_START. >**/
+    std::uint32_t player;
+    eventType type;
+    /**< The ball pulled, or the number called when the square is daubed. >**/
+    std::uint8_t ball;
+    /**< The location of the daubed square. >**/
+    std::uint8_t location;
+    /**< Auto daub for a ball, met for a claim, the card's victory type for
+     a join, the game's victory type for the settings. >**/
+    std::uint8_t flag;
+    /**< The length of a joining player's id, auto daub for the settings,
+     the version for JOURNAL_START. >**/
+    std::uint32_t size;
+    /**< A join's card numbers by location and the start of the id, the
+     next part of the id, or the magic of JOURNAL_START. >**/
+    unsigned char data[44];
+  };
+
+  /**< The bytes of a joining player's id in the join and in an ID_PART. >**/
+  static const unsigned JOIN_ID_BYTES = sizeof(event::data)
+    - WinPatterns::NUM_SQUARES;
+  static const unsigned PART_ID_BYTES = sizeof(event::data);
+
+  /**
+  * @brief The events of a journal, after JOURNAL_START.
+  */
+  struct eventList {
+    const event* data;
+    std::size_t count;
+
+    const event* begin() const {
+      return data;
+    }
+
+    const event* end() const {
+      return data + count;
+    }
+
+    std::size_t size() const {
+      return count;
+    }
+  };
+
+  /**
+  * @brief Constructor, opens the journal to append to it.
+  * @details A new journal is started when the file is empty or missing.
+  *   An existing one is appended to after its last whole event, anything
+  *   after that is cut off.
+  * @param [in] fileName The name of the file.
+  * @param [in] game The type of the game.
+  * @param [in] batchSize The number of events written at a time.
+  * @throw bad_input If the file can't be opened or written, or isn't a
+  *   journal of this version.
+  * @throw card_to_game_mismatch If the journal is of another game type.
+  */
+  GameJournal(const std::string& fileName, BingoTypes::gameType game,
+              unsigned batchSize = 1024);
+
+  /**
+  * @brief Copy constructor, disabled.
+  * @param rv a GameJournal class object.
+  */
+  GameJournal(const GameJournal& rv) = delete;
+
+  /**
+  * @brief Assignment operator, disabled.
+  * @param rv a GameJournal class object.
+  */
+  void operator=(const GameJournal& rv) = delete;
+
+  /**
+  * @brief Destructor, commits what is left, errors are ignored.
+  */
+  virtual ~GameJournal();
+
+  /**
+  * @brief Record a ball pulled.
+  * @param [in] ball The ball.
+  * @param [in] autoDaub true, if the game daubs the ball on every card.
+  */
+  void ballPulled(unsigned ball, bool autoDaub);
+
+  /**
+  * @brief Record a square daubed by a player.
+  * @param [in] player The player's handle.
+  * @param [in] ball The number called when it was daubed.
+  * @param [in] location The location of the square.
+  */
+  void squareDaubed(unsigned player, unsigned ball, unsigned location);
+
+  /**
+  * @brief Record a claim of bingo.
+  * @param [in] player The player's handle.
+  * @param [in] met true, if the card met the victory conditions.
+  */
+  void bingoClaimed(unsigned player, bool met);
+
+  /**
+  * @brief Record a player joining with a new card.
+  * @param [in] player The player's handle.
+  * @param [in] id The player's id.
+  * @param [in] card The card, its numbers and victory type are kept.
+  */
+  void playerJoined(unsigned player, std::string_view id, BingoCard* card);
+
+  /**
+  * @brief Record a player leaving.
+  * @param [in] player The player's handle.
+  */
+  void playerLeft(unsigned player);
+
+  /**
+  * @brief Record a reset of the game.
+  */
+  void gameReset();
+
+  /**
+  * @brief Record the settings of the game, which later joins and balls
+  *   depend on.
+  * @param [in] victory The victory type of the game.
+  * @param [in] autoDaub true, if the game daubs the balls on every card.
+  */
+  void gameSettings(BingoTypes::victoryType victory, bool autoDaub);
+
+  /**
+  * @brief Write the events not yet written and sync the file.
+  * @throw bad_input If the file can't be written.
+  */
+  void commit();
+
+  /**
+  * @brief Access the number of events.
+  * @return The number of events after JOURNAL_START, written or not.
+  */
+  std::size_t getNumEvents() const {
+    return _sequence - 1;
+  }
+
+  /**
+  * @brief The number of ID_PART events after a join.
+  * @param [in] idSize The length of the joining player's id.
+  * @return The number of events the rest of the id takes.
+  */
+  static std::size_t numIdParts(std::size_t idSize) {
+    return idSize <= JOIN_ID_BYTES ? 0
+      : (idSize - JOIN_ID_BYTES + PART_ID_BYTES - 1) / PART_ID_BYTES;
+  }
+
+  /**
+  * @brief Find the whole events of a journal.
+  * @details A join missing some of its ID_PART events at the end is cut
+  *   off with them, as if it were torn.
+  * @param [in] text The contents of the journal file.
+  * @param [in] game The type of the game.
+  * @param [in] fileName The name of the file, for error messages.
+  * @return The events up to the first torn or damaged one.
+  * @throw bad_input If text isn't a journal of this version.
+  * @throw card_to_game_mismatch If the journal is of another game type.
+  */
+  static eventList readEvents(std::string_view text,
+                              BingoTypes::gameType game,
+                              const std::string& fileName);
+
+ private:
+  std::string _fileName;
+  int _fd;
+  /**< The sequence of the next event. >**/
+  std::uint32_t _sequence;
+  /**< The events not yet written. >**/
+  std::vector<event> _pending;
+  unsigned _batchSize;
+
+  /**
+  * @brief Add an event to the batch, writing the batch first if it has no
+  *   room for the event and the ones that must go with it.
+  * @param [in] type The type of the event.
+  * @param [in] player The player's handle.
+  * @param [in] numEvents The event and those that follow it, which are
+  *   added with add so they are written in the same batch.
+  * @return The event, its fields other than the type, player and sequence
+  *   are zero.
+  * @throw bad_input If the batch can't be written.
+  */
+  event& append(eventType type, unsigned player, std::size_t numEvents = 1);
+
+  /**
+  * @brief Add an event to the batch, which may grow past the batch size.
+  * @param [in] type The type of the event.
+  * @param [in] player The player's handle.
+  * @return The event, as from append.
+  */
+  event& add(eventType type, unsigned player);
+
+  /**
+  * @brief Write the batch, without a sync.
+  * @return true, if the batch is written, false if the file can't be
+  *   written, the batch is then kept.
+  */
+  bool writeBatch();
+};
+
+#endif // GAME_JOURNAL_H_INCLUDED
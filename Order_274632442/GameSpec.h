@@ -0,0 +1,270 @@
+#ifndef GAME_SPEC_H_INCLUDED
+#define GAME_SPEC_H_INCLUDED
+
+#include <array>
+#include <string_view>
+
+#include "BingoTypes.h"
+#include "WinPatterns.h"
+
+/**
+* @class GameInfo GameSpec.h "GameSpec.h"
+* @brief The constants of one GameSpec, for code that picks the game at run
+*   time.
+* @details Each GameSpec has one GameInfo pointing at its constexpr tables,
+*   so a caller or card looks the game up once and then only indexes tables.
+*/
+struct GameInfo {
+  BingoTypes::gameType game;
+  unsigned numBalls;
+  unsigned colRange;
+  /**< letters[value] is the column letter of value, letters[0] is 0. >**/
+  const char* letters;
+  /**< The "X:NN" label of value starts at labels + value * labelSize. >**/
+  const char* labels;
+  unsigned labelSize;
+  /**< The announcement of value starts at announcements + value *
+    ANNOUNCEMENT_SIZE. >**/
+  const char* announcements;
+
+  /**< Room for "Letter X, Number NNN". >**/
+  static const unsigned ANNOUNCEMENT_SIZE = 20;
+  /**< The length of "Letter X, Number ". >**/
+  static const unsigned ANNOUNCEMENT_PREFIX = 17;
+
+  /**
+  * @brief The smallest value in a column.
+  * @param [in] col A zero based column.
+  * @return The first value of the column's range.
+  */
+  constexpr unsigned colMin(unsigned col) const {
+    return col * colRange + 1;
+  }
+
+  /**
+  * @brief The largest value in a column.
+  * @param [in] col A zero based column.
+  * @return The last value of the column's range.
+  */
+  constexpr unsigned colMax(unsigned col) const {
+    return (col + 1) * colRange;
+  }
+
+  /**
+  * @brief Determines if value is one of the balls of the game.
+  * @param [in] value Any number.
+  * @return true, if value is in [1, numBalls], false otherwise.
+  */
+  constexpr bool isValidBall(unsigned value) const {
+    return value >= 1 && value <= numBalls;
+  }
+
+  /**
+  * @brief The label of a ball, as it is listed on the board.
+  * @param [in] value A value in [1, numBalls].
+  * @return "B:07" and so on, the value is zero padded to the width of
+  *   numBalls.
+  */
+  constexpr std::string_view label(unsigned value) const {
+    return std::string_view(labels + value * labelSize, labelSize);
+  }
+
+  /**
+  * @brief The announcement of a ball.
+  * @param [in] value A value in [1, numBalls].
+  * @return "Letter B, Number 7" and so on.
+  */
+  constexpr std::string_view announcement(unsigned value) const {
+    return std::string_view(announcements + value * ANNOUNCEMENT_SIZE,
+                            ANNOUNCEMENT_PREFIX + digits(value));
+  }
+
+  /**
+  * @brief The number of decimal digits of a value.
+  * @param [in] value A value less than 1000.
+  * @return 1, 2 or 3.
+  */
+  static constexpr unsigned digits(unsigned value) {
+    return value < 10 ? 1 : value < 100 ? 2 : 3;
+  }
+
+  /**
+  * @brief Look up the GameInfo of a game type.
+  * @param [in] game A game type.
+  * @return The GameInfo of game, a nullptr if game is not a game type.
+  */
+  static const GameInfo* forGame(BingoTypes::gameType game);
+};
+
+/**
+* @class GameSpec GameSpec.h "GameSpec.h"
+* @brief Compile time description of a bingo variant: the number of balls,
+*   the shape of the card and where its free square is.
+* @details The balls are split evenly over the columns, the first column
+*   holds [1, COL_RANGE], the next [COL_RANGE + 1, 2 * COL_RANGE] and so on.
+*   Columns are headed by letters of BINGO, spread evenly when the card has
+*   fewer than five columns. The win patterns and the mapping of (row, col)
+*   to a location come from BasicWinPatterns. Cards, callers and the display
+*   are built on the 5 x 5 WinPatterns, so only 5 x 5 specs can be played;
+*   each has a GameInfo in forGame.
+*/
+template <unsigned Balls, unsigned Rows, unsigned Cols, unsigned FreeIndex>
+class GameSpec : public BasicWinPatterns<Rows, Cols, FreeIndex> {
+ public:
+  typedef BasicWinPatterns<Rows, Cols, FreeIndex> patternsType;
+
+  static const unsigned NUM_BALLS = Balls;
+  static const unsigned COL_RANGE = Balls / Cols;
+
+  static_assert(Cols >= 2 && Cols <= 5, "columns are headed by BINGO");
+  static_assert(Balls % Cols == 0, "each column has the same range");
+  static_assert(COL_RANGE >= Rows, "a column needs a value for every row");
+  static_assert(Balls <= 255, "a Square stores its value in a byte");
+
+  /**
+  * @brief The smallest value in a column.
+  * @param [in] col A zero based column.
+  * @return The first value of the column's range.
+  */
+  static constexpr unsigned colMin(unsigned col) {
+    return col * COL_RANGE + 1;
+  }
+
+  /**
+  * @brief The largest value in a column.
+  * @param [in] col A zero based column.
+  * @return The last value of the column's range.
+  */
+  static constexpr unsigned colMax(unsigned col) {
+    return (col + 1) * COL_RANGE;
+  }
+
+  /**
+  * @brief The zero based column a ball belongs to.
+  * @param [in] value A value in [1, NUM_BALLS].
+  * @return The column of value.
+  */
+  static constexpr unsigned columnOf(unsigned value) {
+    return (value - 1) / COL_RANGE;
+  }
+
+  /**
+  * @brief The letter heading a column.
+  * @param [in] col A zero based column.
+  * @return A letter of BINGO.
+  */
+  static constexpr char columnLetter(unsigned col) {
+    return "BINGO"[col * 4 / (Cols - 1)];
+  }
+
+  /**< LETTERS[value] is the letter of value's column, LETTERS[0] is 0. >**/
+  static constexpr std::array<char, Balls + 1> LETTERS =
+    GameSpec::makeLetters();
+
+  /**< The size of a label, "X:" and the digits of NUM_BALLS. >**/
+  static const unsigned LABEL_SIZE = 2 + GameInfo::digits(Balls);
+
+  /**< The "X:NN" labels, value's label starts at value * LABEL_SIZE. >**/
+  static constexpr std::array<char, (Balls + 1) * LABEL_SIZE> LABELS =
+    GameSpec::makeLabels();
+
+  /**< The announcements, value's starts at value * ANNOUNCEMENT_SIZE. >**/
+  static constexpr std::array<char, (Balls + 1) * GameInfo::ANNOUNCEMENT_SIZE>
+    ANNOUNCEMENTS = GameSpec::makeAnnouncements();
+
+  /**< The run time view of this spec. >**/
+  static constexpr GameInfo INFO = {
+    static_cast<BingoTypes::gameType>(Balls), Balls, COL_RANGE, LETTERS.data(),
+    LABELS.data(), LABEL_SIZE, ANNOUNCEMENTS.data()
+  };
+
+ private:
+  /**
+  * @brief Write the decimal digits of a value.
+  * @param [out] out Where the first digit goes.
+  * @param [in] value The value.
+  * @param [in] width The number of digits, with leading zeros.
+  */
+  static constexpr void writeDigits(char* out, unsigned value,
+                                    unsigned width) {
+    for (unsigned i = width; i > 0; --i) {
+      out[i - 1] = static_cast<char>('0' + value % 10);
+      value /= 10;
+    }
+  }
+
+  /**
+  * @brief Build the LABELS table.
+  * @return The label of every ball.
+  */
+  static constexpr std::array<char, (Balls + 1) * LABEL_SIZE> makeLabels() {
+    std::array<char, (Balls + 1) * LABEL_SIZE> labels{};
+    for (unsigned value = 1; value <= Balls; ++value) {
+      char* label = labels.data() + value * LABEL_SIZE;
+      label[0] = columnLetter(columnOf(value));
+      label[1] = ':';
+      writeDigits(label + 2, value, LABEL_SIZE - 2);
+    }
+    return labels;
+  }
+
+  /**
+  * @brief Build the ANNOUNCEMENTS table.
+  * @return The announcement of every ball.
+  */
+  static constexpr std::array<char, (Balls + 1) * GameInfo::ANNOUNCEMENT_SIZE>
+    makeAnnouncements() {
+    std::array<char, (Balls + 1) * GameInfo::ANNOUNCEMENT_SIZE> text{};
+    for (unsigned value = 1; value <= Balls; ++value) {
+      char* announcement = text.data() + value * GameInfo::ANNOUNCEMENT_SIZE;
+      const char prefix[] = "Letter X, Number ";
+      for (unsigned i = 0; i < GameInfo::ANNOUNCEMENT_PREFIX; ++i) {
+        announcement[i] = prefix[i];
+      }
+      announcement[7] = columnLetter(columnOf(value));
+      writeDigits(announcement + GameInfo::ANNOUNCEMENT_PREFIX, value,
+                  GameInfo::digits(value));
+    }
+    return text;
+  }
+
+  /**
+  * @brief Build the LETTERS table.
+  * @return The column letter of every ball.
+  */
+  static constexpr std::array<char, Balls + 1> makeLetters() {
+    std::array<char, Balls + 1> letters{};
+    for (unsigned value = 1; value <= Balls; ++value) {
+      letters[value] = columnLetter(columnOf(value));
+    }
+    return letters;
+  }
+};
+
+/**< The 75 ball game, BINGO75. >**/
+typedef GameSpec<75, 5, 5, WinPatterns::FREE_LOCATION> Bingo75Spec;
+
+/**< The 50 ball game, BINGO50. >**/
+typedef GameSpec<50, 5, 5, WinPatterns::FREE_LOCATION> Bingo50Spec;
+
+inline const GameInfo* GameInfo::forGame(BingoTypes::gameType game) {
+  switch (game) {
+    case BingoTypes::BINGO75:
+      return &Bingo75Spec::INFO;
+    case BingoTypes::BINGO50:
+      return &Bingo50Spec::INFO;
+    default:
+      return nullptr;
+  }
+}
+
+static_assert(Bingo75Spec::LETTERS[15] == 'B' && Bingo75Spec::LETTERS[16] == 'I'
+              && Bingo75Spec::LETTERS[75] == 'O', "75 ball columns");
+static_assert(Bingo50Spec::LETTERS[10] == 'B' && Bingo50Spec::LETTERS[11] == 'I'
+              && Bingo50Spec::LETTERS[50] == 'O', "50 ball columns");
+static_assert(Bingo75Spec::INFO.label(7) == "B:07" &&
+              Bingo75Spec::INFO.label(75) == "O:75", "75 ball labels");
+static_assert(Bingo50Spec::INFO.announcement(50) == "Letter O, Number 50",
+              "50 ball announcements");
+
+#endif // GAME_SPEC_H_INCLUDED
@@ -1,23 +1,163 @@
 
-#include <iostream>
-#include <ctime>
+#include <cstdint>
 #include <random>
 
 #include "MakeRandomInt.h"
 
-MakeRandomInt::MakeRandomInt() {
-  _seed = time(NULL);
-  _generator = std::default_random_engine(_seed);
+namespace {
+
+std::uint64_t splitMix64(std::uint64_t* state) {
+  std::uint64_t z = (*state += 0x9e3779b97f4a7c15ULL);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+}  // namespace
+
+Xoshiro256ss::Xoshiro256ss(std::uint64_t seed) {
+  this->seed(seed);
+}
+
+void Xoshiro256ss::seed(std::uint64_t seed) {
+  for (std::uint64_t& word : _s) {
+    word = splitMix64(&seed);
+  }
+}
+
+Pcg64::Pcg64(std::uint64_t seed) {
+  this->seed(seed);
+}
+
+void Pcg64::seed(std::uint64_t seed) {
+  _state = 0;
+  next();
+  _state += seed;
+  next();
+}
+
+Philox4x32::Philox4x32(std::uint64_t key, std::uint64_t stream) {
+  seed(key, stream);
+}
+
+void Philox4x32::seed(std::uint64_t key, std::uint64_t stream) {
+  _key[0] = static_cast<std::uint32_t>(key);
+  _key[1] = static_cast<std::uint32_t>(key >> 32);
+  _index = 0;
+  _stream = stream;
+  _used = 2;
+}
+
+void Philox4x32::block(std::uint32_t ctr[4], const std::uint32_t key[2]) {
+  const std::uint32_t M0 = 0xd2511f53u;
+  const std::uint32_t M1 = 0xcd9e8d57u;
+  std::uint32_t k0 = key[0];
+  std::uint32_t k1 = key[1];
+  for (unsigned round = 0; round < 10; ++round) {
+    std::uint64_t p0 = std::uint64_t{M0} * ctr[0];
+    std::uint64_t p1 = std::uint64_t{M1} * ctr[2];
+    std::uint32_t c1 = ctr[1];
+    std::uint32_t c3 = ctr[3];
+    ctr[0] = static_cast<std::uint32_t>(p1 >> 32) ^ c1 ^ k0;
+    ctr[1] = static_cast<std::uint32_t>(p1);
+    ctr[2] = static_cast<std::uint32_t>(p0 >> 32) ^ c3 ^ k1;
+    ctr[3] = static_cast<std::uint32_t>(p0);
+    k0 += 0x9e3779b9u;
+    k1 += 0xbb67ae85u;
+  }
+}
+
+void Philox4x32::refill() {
+  std::uint32_t ctr[4] = {
+    static_cast<std::uint32_t>(_index),
+    static_cast<std::uint32_t>(_index >> 32),
+    static_cast<std::uint32_t>(_stream),
+    static_cast<std::uint32_t>(_stream >> 32)
+  };
+  block(ctr, _key);
+  ++_index;
+  _out[0] = std::uint64_t{ctr[0]} | (std::uint64_t{ctr[1]} << 32);
+  _out[1] = std::uint64_t{ctr[2]} | (std::uint64_t{ctr[3]} << 32);
+  _used = 0;
+}
+
+MakeRandomInt::MakeRandomInt(std::uint64_t seed, engineType engine)
+  : _engine{engine} {
+  this->seed(seed);
+}
+
+MakeRandomInt::MakeRandomInt(std::uint64_t seed, std::uint64_t stream,
+                             engineType engine)
+  : _engine{engine} {
+  this->seed(seed, stream);
 }
 
 MakeRandomInt& MakeRandomInt::getInstance() {
-  static MakeRandomInt instance;
+  thread_local MakeRandomInt instance{
+    (std::uint64_t{std::random_device{}()} << 32) ^ std::random_device{}()};
   return instance;
 }
 
 MakeRandomInt::~MakeRandomInt() {}
 
-int MakeRandomInt::getValue(int max) {
-  std::uniform_int_distribution<int> _distribution(0, max - 1);
-  return _distribution(_generator);
+void MakeRandomInt::setEngine(engineType engine) {
+  _engine = engine;
+  seed(_seed, _stream);
+}
+
+MakeRandomInt::engineType MakeRandomInt::getEngine() {
+  return _engine;
+}
+
+void MakeRandomInt::seed(std::uint64_t seed) {
+  this->seed(seed, 0);
+}
+
+void MakeRandomInt::seed(std::uint64_t seed, std::uint64_t stream) {
+  _seed = seed;
+  _stream = stream;
+  std::uint64_t mixed = seed;
+  if (stream != 0) {
+    mixed ^= splitMix64(&stream);
+  }
+  switch (_engine) {
+    case PCG64:
+      _pcg.seed(mixed);
+      break;
+    case LEGACY:
+      _generator.seed(static_cast<unsigned>(mixed));
+      break;
+    case PHILOX:
+      _philox.seed(seed, _stream);
+      break;
+    default:
+      _xoshiro.seed(mixed);
+  }
+}
+
+std::uint64_t MakeRandomInt::getSeed() {
+  return _seed;
+}
+
+std::uint64_t MakeRandomInt::getStream() {
+  return _stream;
+}
+
+MakeRandomInt::engineState MakeRandomInt::getState() {
+  return {_engine, _seed, _stream, _xoshiro, _pcg, _philox, _generator};
+}
+
+void MakeRandomInt::setState(const engineState& state) {
+  _engine = state.engine;
+  _seed = state.seed;
+  _stream = state.stream;
+  _xoshiro = state.xoshiro;
+  _pcg = state.pcg;
+  _philox = state.philox;
+  _generator = state.generator;
+}
+
+int MakeRandomInt::legacyValue(int max) {
+  std::uniform_int_distribution<int> distribution(0, max - 1);
+  return distribution(_generator);
 }
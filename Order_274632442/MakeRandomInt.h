@@ -2,17 +2,194 @@
 #ifndef MAKE_RANDOM_INT_H_INCLUDED
 #define MAKE_RANDOM_INT_H_INCLUDED
 
+#include <cstdint>
 #include <random>
 
+/**
+* @class Xoshiro256ss MakeRandomInt.h "MakeRandomInt.h"
+* @brief The xoshiro256** generator, 256 bits of state and 64 bit output.
+*/
+class Xoshiro256ss {
+ public:
+  /**
+  * @brief Constructor, expands seed into the state with splitmix64.
+  * @param [in] seed Any value, equal seeds give equal sequences.
+  */
+  explicit Xoshiro256ss(std::uint64_t seed = 0);
+
+  /**
+  * @brief Restart the sequence from a seed.
+  * @param [in] seed Any value.
+  */
+  void seed(std::uint64_t seed);
+
+  /**
+  * @brief Advance the generator.
+  * @return The next 64 random bits.
+  */
+  std::uint64_t next() {
+    std::uint64_t result = rotl(_s[1] * 5, 7) * 9;
+    std::uint64_t t = _s[1] << 17;
+    _s[2] ^= _s[0];
+    _s[3] ^= _s[1];
+    _s[1] ^= _s[2];
+    _s[0] ^= _s[3];
+    _s[2] ^= t;
+    _s[3] = rotl(_s[3], 45);
+    return result;
+  }
+
+ private:
+  std::uint64_t _s[4];
+
+  static std::uint64_t rotl(std::uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+  }
+};
+
+/**
+* @class Pcg64 MakeRandomInt.h "MakeRandomInt.h"
+* @brief The PCG XSL RR 128/64 generator, 128 bits of state and 64 bit
+*   output.
+*/
+class Pcg64 {
+ public:
+  /**
+  * @brief Constructor.
+  * @param [in] seed Any value, equal seeds give equal sequences.
+  */
+  explicit Pcg64(std::uint64_t seed = 0);
+
+  /**
+  * @brief Restart the sequence from a seed.
+  * @param [in] seed Any value.
+  */
+  void seed(std::uint64_t seed);
+
+  /**
+  * @brief Advance the generator.
+  * @return The next 64 random bits.
+  */
+  std::uint64_t next() {
+    _state = _state * MULTIPLIER + INCREMENT;
+    std::uint64_t x = static_cast<std::uint64_t>(_state >> 64) ^
+      static_cast<std::uint64_t>(_state);
+    unsigned rot = static_cast<unsigned>(_state >> 122);
+    return (x >> rot) | (x << ((64 - rot) & 63));
+  }
+
+ private:
+  unsigned __int128 _state;
+
+  static constexpr unsigned __int128 MULTIPLIER =
+    (static_cast<unsigned __int128>(2549297995355413924ULL) << 64) |
+    4865540595714422341ULL;
+  static constexpr unsigned __int128 INCREMENT =
+    (static_cast<unsigned __int128>(6364136223846793005ULL) << 64) |
+    1442695040888963407ULL;
+};
+
+/**
+* @class Philox4x32 MakeRandomInt.h "MakeRandomInt.h"
+* @brief The Philox4x32-10 counter based generator.
+* @details Output block n of stream s is a pure function of the key and
+*   the counter (n, s), so any stream can be regenerated on any thread, in
+*   any order, from its key and stream id alone.
+*/
+class Philox4x32 {
+ public:
+  /**
+  * @brief Constructor.
+  * @param [in] key The key, usually the seed of a simulation.
+  * @param [in] stream The stream id, e.g. a game or card id.
+  */
+  explicit Philox4x32(std::uint64_t key = 0, std::uint64_t stream = 0);
+
+  /**
+  * @brief Restart at the first block of a stream.
+  * @param [in] key The key, usually the seed of a simulation.
+  * @param [in] stream The stream id, e.g. a game or card id.
+  */
+  void seed(std::uint64_t key, std::uint64_t stream);
+
+  /**
+  * @brief Advance the generator.
+  * @return The next 64 random bits of the stream.
+  */
+  std::uint64_t next() {
+    if (_used == 2) {
+      refill();
+    }
+    return _out[_used++];
+  }
+
+  /**
+  * @brief Compute one block, ten Philox rounds over the counter.
+  * @param [in, out] ctr The counter, replaced by the random block.
+  * @param [in] key The two key words.
+  */
+  static void block(std::uint32_t ctr[4], const std::uint32_t key[2]);
+
+ private:
+  std::uint32_t _key[2];
+  std::uint64_t _index;
+  std::uint64_t _stream;
+  std::uint64_t _out[2];
+  unsigned _used;
+
+  /**
+  * @brief Compute the block at _index and advance _index.
+  */
+  void refill();
+};
+
 /**
  * @class MakeRandomInt MakeRandomInt.h "MakeRandomInt.h"
  * @brief A class for generating a random int in the range [0, max).
- * @details This class uses the Singleton design pattern to prevent
- * the same list of "random values" from being created by multiple
- * objects within a project.
+ * @details Each thread has its own instance, so threads never share an
+ * engine or need a lock. The engine can be picked and seeded explicitly,
+ * so a game can be replayed from its seed. Bounded values use Lemire's
+ * multiply-shift, which is free of modulo bias and usually needs no
+ * division. With the PHILOX engine the values of a (seed, stream) pair do
+ * not depend on anything else, so games and cards keyed by their id come
+ * out the same on one thread or many.
  */
 class MakeRandomInt {
  public:
+  /**< XOSHIRO256SS is the default, LEGACY is the engine used before. >**/
+  enum engineType {XOSHIRO256SS, PCG64, LEGACY, PHILOX};
+
+  /**
+   * @brief Everything the next values depend on, plain bytes that can be
+   *   saved and loaded.
+   */
+  struct engineState {
+    engineType engine;
+    std::uint64_t seed;
+    std::uint64_t stream;
+    Xoshiro256ss xoshiro;
+    Pcg64 pcg;
+    Philox4x32 philox;
+    std::default_random_engine generator;
+  };
+
+  /**
+   * @brief Constructor, for code that wants its own generator.
+   * @param [in] seed The seed of the engine.
+   * @param [in] engine The engine to draw from.
+   */
+  explicit MakeRandomInt(std::uint64_t seed,
+                         engineType engine = XOSHIRO256SS);
+
+  /**
+   * @brief Constructor, for a counter based stream keyed by an id.
+   * @param [in] seed The seed, the key of the stream.
+   * @param [in] stream The stream id, e.g. a game or card id.
+   * @param [in] engine The engine to draw from.
+   */
+  MakeRandomInt(std::uint64_t seed, std::uint64_t stream,
+                engineType engine = PHILOX);
+
   /**
    * @brief Copy constructor, disabled.
    * @param rv a MakeRandomInt class object.
@@ -31,28 +208,131 @@ class MakeRandomInt {
   virtual ~MakeRandomInt();
 
   /**
-   * @brief Method used to create or obtain the random value object
-   * @return a reference to a random value maker.
+   * @brief Method used to create or obtain the calling thread's random
+   *   value object.
+   * @details It starts with the default engine and a seed from
+   *   std::random_device.
+   * @return a reference to this thread's random value maker.
    */
   static MakeRandomInt& getInstance();
 
+  /**
+   * @brief Switch engines, the new engine is seeded with the last seed and
+   *   stream.
+   * @param [in] engine The engine to draw from.
+   */
+  void setEngine(engineType engine);
+
+  /**
+   * @brief Access the engine in use.
+   * @return The engine type.
+   */
+  engineType getEngine();
+
+  /**
+   * @brief Restart the engine from a seed, e.g. at the start of a game.
+   * @param [in] seed Any value, equal seeds give equal sequences.
+   */
+  void seed(std::uint64_t seed);
+
+  /**
+   * @brief Restart the engine at one stream of a seed.
+   * @details The PHILOX engine uses the stream as the high half of its
+   *   counter, the other engines mix it into the seed.
+   * @param [in] seed Any value.
+   * @param [in] stream The stream id, e.g. a game or card id.
+   */
+  void seed(std::uint64_t seed, std::uint64_t stream);
+
+  /**
+   * @brief Access the last seed.
+   * @return The seed the engine was last started from.
+   */
+  std::uint64_t getSeed();
+
+  /**
+   * @brief Access the last stream.
+   * @return The stream the engine was last started on.
+   */
+  std::uint64_t getStream();
+
+  /**
+   * @brief Save the state of the engines.
+   * @return The state, the same values follow it.
+   */
+  engineState getState();
+
+  /**
+   * @brief Continue from a saved state.
+   * @param [in] state A state from getState.
+   */
+  void setState(const engineState& state);
+
   /**
    * @brief Get a random int in the range [0, max).
    * @param max the upper bound for the range of possible values.
-   * @return an integer in the range [0, max).
+   * @return an integer in the range [0, max), 0 if max is less than 2.
    */
-  int getValue(int max = 10);
+  int getValue(int max = 10) {
+    if (max < 2) {
+      return 0;
+    }
+    if (_engine == LEGACY) {
+      return legacyValue(max);
+    }
+    return static_cast<int>(bounded(static_cast<std::uint32_t>(max)));
+  }
+
+  /**
+   * @brief Get 64 random bits.
+   * @return The next output of the engine.
+   */
+  std::uint64_t getBits() {
+    switch (_engine) {
+      case XOSHIRO256SS:
+        return _xoshiro.next();
+      case PCG64:
+        return _pcg.next();
+      case PHILOX:
+        return _philox.next();
+      default:
+        return (std::uint64_t{_generator()} << 32) ^ _generator();
+    }
+  }
 
  private:
-//  static MakeRandomInt* _instance;
-  unsigned _seed;
+  engineType _engine;
+  std::uint64_t _seed;
+  std::uint64_t _stream;
+  Xoshiro256ss _xoshiro;
+  Pcg64 _pcg;
+  Philox4x32 _philox;
   std::default_random_engine _generator;
-  std::uniform_int_distribution<int> _distribution;
 
   /**
-   * @brief The default constructor called by getInstance.
+   * @brief The bounded value from the 64 bit engines.
+   * @param [in] range The size of the range, at least 1.
+   * @return A value in [0, range).
+   */
+  std::uint32_t bounded(std::uint32_t range) {
+    std::uint64_t product = (getBits() >> 32) * range;
+    std::uint32_t low = static_cast<std::uint32_t>(product);
+    if (low < range) {
+      std::uint32_t threshold = -range % range;
+      while (low < threshold) {
+        product = (getBits() >> 32) * range;
+        low = static_cast<std::uint32_t>(product);
+      }
+    }
+    return static_cast<std::uint32_t>(product >> 32);
+  }
+
+  /**
+   * @brief The bounded value from the legacy engine, as it was drawn before.
+   * @param [in] max The size of the range, at least 2.
+   * @return A value in [0, max).
    */
-  MakeRandomInt();
+  int legacyValue(int max);
 };
 
 #endif // MAKE_RANDOM_INT_H_INCLUDED
@@ -0,0 +1,53 @@
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+#include "MappedFile.h"
+#include "Exceptions.h"
+
+MappedFile::MappedFile(const std::string& fileName, const char* kind,
+                       bool writable)
+  : _data{nullptr}, _size{0} {
+  int fd = ::open(fileName.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw bad_input(("Could not open the " + std::string(kind) + " file " +
+                     fileName + ".").c_str());
+  }
+  struct stat info;
+  if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+    int protection = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+    int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+    if (!writable) {
+      flags |= MAP_POPULATE;
+    }
+#endif
+    _size = static_cast<std::size_t>(info.st_size);
+    void* data = ::mmap(nullptr, _size, protection, flags, fd, 0);
+    if (data != MAP_FAILED) {
+      _data = static_cast<const char*>(data);
+    }
+  }
+  ::close(fd);
+  if (_size != 0 && _data == nullptr) {
+    throw bad_input(("Could not read the " + std::string(kind) + " file " +
+                     fileName + ".").c_str());
+  }
+}
+
+bool MappedFile::contains(const void* p) const {
+  std::less<const void*> before;
+  return _data != nullptr && !before(p, _data) && before(p, _data + _size);
+}
+
+MappedFile::~MappedFile() {
+  if (_data != nullptr) {
+    ::munmap(const_cast<char*>(_data), _size);
+  }
+}
@@ -0,0 +1,74 @@
+
+#ifndef MAPPED_FILE_H_INCLUDED
+#define MAPPED_FILE_H_INCLUDED
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/**
+* @class MappedFile MappedFile.h "MappedFile.h"
+* @brief A private mapping of a whole file, unmapped on destruction.
+* @details A read only mapping reads the pages in when the file is mapped,
+*   so the caller doesn't take a page fault per page afterwards. A writable
+*   mapping copies a page the first time it is written, the file is never
+*   changed.
+*/
+class MappedFile {
+ public:
+  /**
+  * @brief Constructor, maps the file.
+  * @param [in] fileName The name of the file.
+  * @param [in] kind What the file holds, for error messages, e.g. "clues".
+  * @param [in] writable true to map the file writable.
+  * @throw bad_input If the file can't be opened or mapped.
+  */
+  MappedFile(const std::string& fileName, const char* kind,
+             bool writable = false);
+
+  /**
+  * @brief Copy constructor, disabled.
+  * @param rv a MappedFile class object.
+  */
+  MappedFile(const MappedFile& rv) = delete;
+
+  /**
+  * @brief Assignment operator, disabled.
+  * @param rv a MappedFile class object.
+  */
+  void operator=(const MappedFile& rv) = delete;
+
+  /**
+  * @brief Destructor, unmaps the file.
+  */
+  virtual ~MappedFile();
+
+  /**
+  * @brief Access the contents.
+  * @return The bytes of the file, empty for an empty file.
+  */
+  std::string_view getText() const {
+    return std::string_view(_data, _size);
+  }
+
+  /**
+  * @brief Access the contents of a writable mapping.
+  * @return The bytes of the file, only written to if mapped writable.
+  */
+  char* getData() {
+    return const_cast<char*>(_data);
+  }
+
+  /**
+  * @brief Determines if p points into the mapping.
+  * @param [in] p Any pointer.
+  * @return true, if p is in the mapped file, false otherwise.
+  */
+  bool contains(const void* p) const;
+
+ private:
+  const char* _data;
+  std::size_t _size;
+};
+
+#endif // MAPPED_FILE_H_INCLUDED
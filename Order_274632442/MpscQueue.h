@@ -0,0 +1,139 @@
+
+#ifndef MPSC_QUEUE_H_INCLUDED
+#define MPSC_QUEUE_H_INCLUDED
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+/**
+* @class MpscQueue MpscQueue.h "MpscQueue.h"
+* @brief A bounded lock free queue for many producer threads and one
+*   consumer thread.
+* @details The slots form a ring of a power of two size, each with a
+*   sequence number that says whose turn it is. A producer claims a slot
+*   with one compare and swap on _tail, fills it and publishes it by
+*   advancing the slot's sequence, so producers never wait on each other or
+*   on the consumer; push fails instead when the ring is full. The consumer
+*   owns _head and takes published slots in order, in batches with
+*   popBatch.
+* @tparam T The item type, default constructible and move assignable.
+*/
+template <typename T>
+class MpscQueue {
+ public:
+  /**
+  * @brief Constructor.
+  * @param [in] capacity The least number of items the queue can hold, it
+  *   is rounded up to a power of two.
+  */
+  explicit MpscQueue(std::size_t capacity)
+    : _mask{roundUp(capacity) - 1}, _slots{new slot[_mask + 1]},
+      _head{0}, _tail{0} {
+    for (std::size_t i = 0; i <= _mask; ++i) {
+      _slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+  * @brief Copy constructor, disabled.
+  * @param rv a MpscQueue class object.
+  */
+  MpscQueue(const MpscQueue& rv) = delete;
+
+  /**
+  * @brief Assignment operator, disabled.
+  * @param rv a MpscQueue class object.
+  */
+  void operator=(const MpscQueue& rv) = delete;
+
+  /**
+  * @brief Add an item, from any thread.
+  * @param [in] item The item, moved from only if it is added.
+  * @return true, if the item is added, false if the queue is full.
+  */
+  bool push(T& item) {
+    std::size_t tail = _tail.load(std::memory_order_relaxed);
+    while (true) {
+      slot& s = _slots[tail & _mask];
+      std::ptrdiff_t lag = static_cast<std::ptrdiff_t>(
+        s.sequence.load(std::memory_order_acquire) - tail);
+      if (lag == 0) {
+        if (_tail.compare_exchange_weak(tail, tail + 1,
+                                        std::memory_order_relaxed)) {
+          s.item = std::move(item);
+          s.sequence.store(tail + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (lag < 0) {
+        return false;
+      } else {
+        tail = _tail.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /**
+  * @brief Remove the oldest item, only called by the consumer.
+  * @param [out] item Where the item is moved to.
+  * @return true, if an item is removed, false if none is published.
+  */
+  bool pop(T& item) {
+    return popBatch(&item, 1) == 1;
+  }
+
+  /**
+  * @brief Remove the oldest items, only called by the consumer.
+  * @details Stops at the first slot that is not published yet, so items
+  *   come out in the order their slots were claimed.
+  * @param [out] items Where the items are moved to.
+  * @param [in] maxItems The most items to remove.
+  * @return The number of items removed.
+  */
+  std::size_t popBatch(T* items, std::size_t maxItems) {
+    std::size_t head = _head.load(std::memory_order_relaxed);
+    std::size_t count = 0;
+    while (count < maxItems) {
+      slot& s = _slots[head & _mask];
+      if (s.sequence.load(std::memory_order_acquire) != head + 1) {
+        break;
+      }
+      items[count++] = std::move(s.item);
+      s.sequence.store(head + _mask + 1, std::memory_order_release);
+      ++head;
+    }
+    _head.store(head, std::memory_order_relaxed);
+    return count;
+  }
+
+ private:
+  static const std::size_t CACHE_LINE = 64;
+
+  struct slot {
+    std::atomic<std::size_t> sequence;
+    T item;
+  };
+
+  std::size_t _mask;
+  std::unique_ptr<slot[]> _slots;
+  /**< The consumer's side. >**/
+  alignas(CACHE_LINE) std::atomic<std::size_t> _head;
+  /**< The producers' side. >**/
+  alignas(CACHE_LINE) std::atomic<std::size_t> _tail;
+
+  /**
+  * @brief The least power of two at least n.
+  * @param [in] n The capacity asked for.
+  * @return The capacity of the ring, at least 2.
+  */
+  static std::size_t roundUp(std::size_t n) {
+    std::size_t size = 2;
+    while (size < n) {
+      size *= 2;
+    }
+    return size;
+  }
+};
+
+#endif // MPSC_QUEUE_H_INCLUDED
@@ -0,0 +1,92 @@
+#include <cstddef>
+#include <vector>
+
+#include "NumberIndex.h"
+#include "BingoCard.h"
+#include "BingoTypes.h"
+#include "Square.h"
+#include "WinPatterns.h"
+#include "Exceptions.h"
+
+NumberIndex::NumberIndex(unsigned numBalls) {
+  reset(numBalls);
+}
+
+NumberIndex::~NumberIndex() {}
+
+void NumberIndex::reset(unsigned numBalls) {
+  _postings.clear();
+  _postings.resize(numBalls + 1);
+  _shared.assign(numBalls + 1, postingList{nullptr, 0});
+}
+
+void NumberIndex::addCard(unsigned card, BingoCard* bingoCard) {
+  if (bingoCard == nullptr) {
+    throw bad_input("Cannot index a nullptr card.");
+  }
+
+  for (unsigned row = 1; row <= WinPatterns::NUM_ROWS; ++row) {
+    for (unsigned col = 1; col <= WinPatterns::NUM_COLS; ++col) {
+      unsigned value = bingoCard->getSquare({row, col})->getValue();
+      if (value == 0) {
+        continue;  // the free square
+      }
+      if (value >= _postings.size()) {
+        throw bad_input("The card has a value that is not a ball in the game.");
+      }
+      unsigned location = WinPatterns::location(row - 1, col - 1);
+      ownPostings(value).push_back({card, location});
+    }
+  }
+}
+
+void NumberIndex::removeCard(unsigned card, BingoCard* bingoCard) {
+  if (bingoCard == nullptr) {
+    throw bad_input("Cannot remove a nullptr card from the index.");
+  }
+
+  for (unsigned row = 1; row <= WinPatterns::NUM_ROWS; ++row) {
+    for (unsigned col = 1; col <= WinPatterns::NUM_COLS; ++col) {
+      unsigned value = bingoCard->getSquare({row, col})->getValue();
+      if (value == 0 || value >= _postings.size()) {
+        continue;
+      }
+      std::vector<posting>& list = ownPostings(value);
+      for (unsigned i = 0; i < list.size(); ++i) {
+        if (list[i].card == card) {
+          list[i] = list.back();
+          list.pop_back();
+          break;
+        }
+      }
+    }
+  }
+}
+
+NumberIndex::postingList NumberIndex::getPostings(unsigned ball) {
+  if (ball >= _postings.size()) {
+    return {nullptr, 0};
+  }
+  if (_shared[ball].count != 0) {
+    return _shared[ball];
+  }
+  return {_postings[ball].data(), _postings[ball].size()};
+}
+
+void NumberIndex::sharePostings(unsigned ball, const posting* postings,
+                                std::size_t numPostings) {
+  if (ball == 0 || ball >= _postings.size()) {
+    throw bad_input("Cannot index a value that is not a ball.");
+  }
+  _postings[ball].clear();
+  _shared[ball] = {postings, numPostings};
+}
+
+std::vector<NumberIndex::posting>& NumberIndex::ownPostings(unsigned ball) {
+  postingList& shared = _shared[ball];
+  if (shared.count != 0) {
+    _postings[ball].assign(shared.begin(), shared.end());
+    shared = {nullptr, 0};
+  }
+  return _postings[ball];
+}
@@ -0,0 +1,116 @@
+#ifndef NUMBER_INDEX_H_INCLUDED
+#define NUMBER_INDEX_H_INCLUDED
+
+#include <cstddef>
+#include <vector>
+
+#include "BingoCard.h"
+
+/**
+* @class NumberIndex NumberIndex.h "NumberIndex.h"
+* @brief Inverted index from each ball value to the cards holding it.
+* @details For every value in [1, numBalls] the index keeps a compact list
+*   of postings, the card id and square location of each square with that
+*   value. A called ball then only visits the cards that contain it, about
+*   one card in fifteen for a 75 ball game.
+*/
+class NumberIndex {
+ public:
+  /**
+  * @brief The square holding a value, on one card.
+  */
+  struct posting {
+    unsigned card;
+    unsigned location;
+  };
+
+  /**
+  * @brief A view of the postings of one ball, valid until the index
+  *   changes.
+  */
+  struct postingList {
+    const posting* data;
+    std::size_t count;
+
+    const posting* begin() const {
+      return data;
+    }
+
+    const posting* end() const {
+      return data + count;
+    }
+
+    std::size_t size() const {
+      return count;
+    }
+  };
+
+  /**
+  * @brief Default constructor.
+  * @param [in] numBalls The number of balls in the game.
+  */
+  NumberIndex(unsigned numBalls = 75);
+
+  /**
+  * @brief Destructor.
+  */
+  virtual ~NumberIndex();
+
+  /**
+  * @brief Remove all postings and change the number of balls.
+  * @param [in] numBalls The number of balls in the game.
+  */
+  void reset(unsigned numBalls);
+
+  /**
+  * @brief Add a posting for each numbered square of a card.
+  * @param [in] card The id of the card.
+  * @param [in] bingoCard A pointer to the card.
+  * @throw bad_input if bingoCard is a nullptr or has a value larger
+  *   than the number of balls.
+  */
+  void addCard(unsigned card, BingoCard* bingoCard);
+
+  /**
+  * @brief Remove the postings of a card.
+  * @param [in] card The id of the card.
+  * @param [in] bingoCard A pointer to the card, used to find its values.
+  * @throw bad_input if bingoCard is a nullptr.
+  */
+  void removeCard(unsigned card, BingoCard* bingoCard);
+
+  /**
+  * @brief Access the postings of a ball.
+  * @param [in] ball The value of a ball.
+  * @return The squares holding that value, empty if the value is not valid.
+  */
+  postingList getPostings(unsigned ball);
+
+  /**
+  * @brief Replace the postings of a ball with postings in memory the
+  *   caller keeps, e.g. a mapped snapshot.
+  * @details Nothing is copied. The postings are read in place until a card
+  *   with the value is added or removed, which copies them into the index
+  *   first. The memory must outlive the index, or the next reset.
+  * @param [in] ball The value of a ball.
+  * @param [in] postings The postings.
+  * @param [in] numPostings The number of postings.
+  * @throw bad_input If the value is not valid.
+  */
+  void sharePostings(unsigned ball, const posting* postings,
+                     std::size_t numPostings);
+
+ private:
+  std::vector<std::vector<posting>> _postings;
+  /**< The postings of sharePostings, count is 0 once they are copied. >**/
+  std::vector<postingList> _shared;
+
+  /**
+  * @brief Access the postings of a ball for a change.
+  * @param [in] ball The value of a valid ball.
+  * @return The ball's postings, copied in if they were shared.
+  */
+  std::vector<posting>& ownPostings(unsigned ball);
+};
+
+#endif // NUMBER_INDEX_H_INCLUDED
@@ -0,0 +1,135 @@
+
+#include <cctype>
+#include <cstddef>
+#include <exception>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+
+#include "BingoGame.h"
+#include "BingoTypes.h"
+#include "PlayerSession.h"
+#include "ScreenDisplay.h"
+#include "UserInput.h"
+
+#include "Exceptions.h"
+
+namespace {
+
+/**
+* @brief A read only streambuf over characters owned by someone else, so
+*   UserInput can read an answer without copying it.
+*/
+class viewBuf : public std::streambuf {
+ public:
+  viewBuf(const char* text, std::size_t size) {
+    char* begin = const_cast<char*>(text);
+    setg(begin, begin, begin + size);
+  }
+};
+
+}  // namespace
+
+PlayerSession::PlayerSession(BingoGame* game, BingoGame::playerHandle player)
+  : _game{game}, _player{player}, _state{AWAIT_MOVE} {
+  if (game == nullptr) {
+    throw bad_input("Game cannot be a nullptr.");
+  }
+}
+
+PlayerSession::~PlayerSession() {}
+
+void PlayerSession::start(std::ostream& out) {
+  ScreenDisplay screen;
+  screen.displayMoveTypePrompt(out);
+}
+
+bool PlayerSession::resume(std::ostream& out, std::string_view input) {
+  if (_state == FINISHED) {
+    return false;
+  }
+  _pending.append(input.data(), input.size());
+
+  std::size_t begin = 0;
+  while (_state != FINISHED) {
+    std::size_t end = step(out, begin);
+    if (end == begin) {
+      break;
+    }
+    begin = end;
+  }
+
+  if (_state == FINISHED) {
+    _pending.clear();
+  } else {
+    _pending.erase(0, begin);
+  }
+  return _state != FINISHED;
+}
+
+void PlayerSession::run(std::ostream& out, std::istream& in) {
+  start(out);
+  std::string line;
+  while (_state != FINISHED && std::getline(in, line)) {
+    line += '\n';
+    resume(out, line);
+  }
+}
+
+std::size_t PlayerSession::step(std::ostream& out, std::size_t begin) {
+  std::size_t end = findAnswer(begin, _state == AWAIT_MOVE ? 1 : 2);
+  if (end == begin) {
+    return begin;
+  }
+
+  viewBuf buf(_pending.data() + begin, end - begin);
+  std::istream in(&buf);
+  UserInput ui;
+  ScreenDisplay screen;
+  try {
+    if (_state == AWAIT_MOVE) {
+      BingoTypes::moveType move = ui.getMoveType(in);
+      if (move == BingoTypes::DAUB) {
+        screen.displaySquarePositionPrompt(out);
+        _state = AWAIT_SQUARE;
+        return end;
+      }
+      _game->takeAction(out, {_player, move, {0, 0}});
+      if (move == BingoTypes::QUIT_GAME) {
+        _state = FINISHED;
+        return end;
+      }
+    } else {
+      _state = AWAIT_MOVE;
+      _game->takeAction(out, {_player, BingoTypes::DAUB,
+                              ui.getSquarePosition(in)});
+    }
+  } catch (const std::exception& e) {
+    screen.displayCallerMessage(out, std::string(e.what()) + "\n");
+    _state = AWAIT_MOVE;
+  }
+  screen.displayMoveTypePrompt(out);
+  return end;
+}
+
+std::size_t PlayerSession::findAnswer(std::size_t begin,
+                                      unsigned numWords) const {
+  std::size_t i = begin;
+  std::size_t size = _pending.size();
+  for (unsigned word = 0; word < numWords; ++word) {
+    while (i < size && isspace(static_cast<unsigned char>(_pending[i]))) {
+      ++i;
+    }
+    if (i == size) {
+      return begin;
+    }
+    while (i < size && !isspace(static_cast<unsigned char>(_pending[i]))) {
+      ++i;
+    }
+    if (i == size) {
+      return begin;
+    }
+  }
+  return i;
+}
@@ -0,0 +1,111 @@
+
+#ifndef PLAYER_SESSION_H_INCLUDED
+#define PLAYER_SESSION_H_INCLUDED
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "BingoGame.h"
+
+/**
+* @class PlayerSession PlayerSession.h "PlayerSession.h"
+* @brief One player's prompt and response exchange, suspended while the
+*   player has not answered.
+* @details A session never waits for input. resume is called with whatever
+*   text arrived for the player, runs the exchange as far as that text
+*   allows and returns, keeping an unfinished answer for the next call. So
+*   one thread can hold a session per player, in a vector indexed by
+*   playerHandle, and resume each one as its input arrives, while a slow
+*   player only holds up itself. Answers are read with UserInput, through
+*   an istream over the session's text, and applied with
+*   BingoGame::takeAction, so the prompts, messages and errors are the ones
+*   of the blocking moves.
+*/
+class PlayerSession {
+ public:
+  /**< Where the exchange is suspended. >**/
+  enum sessionState {AWAIT_MOVE, AWAIT_SQUARE, FINISHED};
+
+  /**
+  * @brief Constructor.
+  * @param [in] game The player's game.
+  * @param [in] player The player's handle in game.
+  * @throw bad_input If game is a nullptr.
+  */
+  PlayerSession(BingoGame* game, BingoGame::playerHandle player);
+
+  /**
+  * @brief Destructor.
+  */
+  virtual ~PlayerSession();
+
+  /**
+  * @brief Access the player.
+  * @return The player's handle.
+  */
+  BingoGame::playerHandle getPlayer() const {
+    return _player;
+  }
+
+  /**
+  * @brief Access the state of the exchange.
+  * @return What the session waits for, FINISHED after the player quits.
+  */
+  sessionState getState() const {
+    return _state;
+  }
+
+  /**
+  * @brief Prompt the player for a move.
+  * @param [inout] out Insert prompts and information in this ostream.
+  */
+  void start(std::ostream& out);
+
+  /**
+  * @brief Continue the exchange with input from the player.
+  * @details Every complete answer in the input is handled in order. An
+  *   answer is complete once the whitespace after it has arrived, the rest
+  *   is kept for the next call. An answer that can't be read or a move that
+  *   fails is reported to the player, who is asked for a move again.
+  * @param [inout] out Insert prompts and information in this ostream.
+  * @param [in] input The text that arrived, any part of a line or lines.
+  * @return false, if the player has quit, true otherwise.
+  */
+  bool resume(std::ostream& out, std::string_view input);
+
+  /**
+  * @brief Run the whole exchange reading a line at a time from an istream.
+  * @details For the console, where waiting on the player is fine.
+  * @param [inout] out Insert prompts and information in this ostream.
+  * @param [inout] in Extract data from this istream.
+  */
+  void run(std::ostream& out, std::istream& in);
+
+ private:
+  BingoGame* _game;
+  BingoGame::playerHandle _player;
+  sessionState _state;
+  /**< The input not yet used, it starts with an unfinished answer. >**/
+  std::string _pending;
+
+  /**
+  * @brief Handle the answer starting at an offset of _pending.
+  * @param [inout] out Insert prompts and information in this ostream.
+  * @param [in] begin The offset of the answer.
+  * @return The offset after the answer, begin if it isn't complete.
+  */
+  std::size_t step(std::ostream& out, std::size_t begin);
+
+  /**
+  * @brief Find the end of the next words in _pending.
+  * @param [in] begin The offset to start from.
+  * @param [in] numWords The number of words in the answer.
+  * @return The offset after the last word, begin if they haven't all
+  *   arrived.
+  */
+  std::size_t findAnswer(std::size_t begin, unsigned numWords) const;
+};
+
+#endif // PLAYER_SESSION_H_INCLUDED
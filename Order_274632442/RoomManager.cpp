@@ -0,0 +1,299 @@
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "BingoCaller.h"
+#include "BingoCardFactory.h"
+#include "BingoGame.h"
+#include "BingoTypes.h"
+#include "RoomManager.h"
+#include "SpscQueue.h"
+#include "VictoryCondition.h"
+
+#include "Exceptions.h"
+
+namespace {
+
+/**
+* @brief A message from the manager to a shard.
+*/
+struct roomMessage {
+  RoomManager::messageType type;
+  unsigned long room;
+  BingoTypes::gameType game;
+  BingoTypes::victoryType victory;
+  bool autoDaub;
+  std::string id;
+  std::chrono::steady_clock::time_point sent;
+};
+
+/**
+* @brief A BingoGame with the caller, victory condition and roster it
+*   needs, owned by one shard.
+*/
+struct Room {
+  Room(BingoTypes::gameType game, BingoTypes::victoryType victory,
+       bool autoDaub)
+    : condition{victory} {
+    if (game == BingoTypes::BINGO50) {
+      caller.reset(new Bingo50Caller(victory));
+    } else {
+      caller.reset(new Bingo75Caller(victory));
+    }
+    this->game.setCaller(caller.get());
+    this->game.setAutoDaub(autoDaub);
+  }
+
+  std::unique_ptr<BingoCaller> caller;
+  VictoryCondition condition;
+  BingoGame game;
+  std::vector<std::string> roster;
+  std::ostringstream out;
+};
+
+}  // namespace
+
+/**
+* @class RoomShard
+* @brief One worker thread and the rooms pinned to it.
+*/
+class RoomShard {
+ public:
+  RoomShard(unsigned index, unsigned queueSize)
+    : _inbox{queueSize}, _outbox{queueSize}, _stopping{false},
+      _thread{&RoomShard::run, this, index} {}
+
+  RoomShard(const RoomShard& rv) = delete;
+  void operator=(const RoomShard& rv) = delete;
+
+  /**
+  * @brief Stop the thread once it has handled the messages already sent.
+  * @details Replies that do not fit the outbox are dropped from now on.
+  */
+  void stop() {
+    _stopping.store(true, std::memory_order_relaxed);
+  }
+
+  void join() {
+    _thread.join();
+  }
+
+  SpscQueue<roomMessage>& inbox() {
+    return _inbox;
+  }
+
+  SpscQueue<RoomManager::roomReply>& outbox() {
+    return _outbox;
+  }
+
+ private:
+  SpscQueue<roomMessage> _inbox;
+  SpscQueue<RoomManager::roomReply> _outbox;
+  std::atomic<bool> _stopping;
+  std::unordered_map<unsigned long, std::unique_ptr<Room>> _rooms;
+  BingoCardFactory _factory;
+  std::thread _thread;
+
+  void run(unsigned index) {
+#ifdef __linux__
+    // The shard is left unpinned when the number of cores is not known.
+    unsigned numCores = std::thread::hardware_concurrency();
+    if (numCores != 0) {
+      cpu_set_t cpus;
+      CPU_ZERO(&cpus);
+      CPU_SET(index % numCores, &cpus);
+      pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+    }
+#endif
+    roomMessage message;
+    unsigned idle = 0;
+    while (true) {
+      if (!_inbox.pop(message)) {
+        // Spin while messages are likely, then give the core away.
+        if (++idle < 64) {
+          continue;
+        }
+        if (idle < 4096) {
+          std::this_thread::yield();
+        } else {
+          std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+        continue;
+      }
+      idle = 0;
+      if (message.type == RoomManager::STOP_SHARD) {
+        break;
+      }
+      handle(message);
+    }
+    _rooms.clear();
+  }
+
+  void handle(roomMessage& message) {
+    RoomManager::roomReply reply{message.room, message.type, true, false,
+      std::string(), message.sent, message.sent};
+    try {
+      if (message.type == RoomManager::CREATE_ROOM) {
+        // Only a room that was built is added, a failed create leaves no
+        // entry behind.
+        std::unique_ptr<Room> room(
+          new Room(message.game, message.victory, message.autoDaub));
+        _rooms[message.room] = std::move(room);
+      } else {
+        auto it = _rooms.find(message.room);
+        if (it == _rooms.end()) {
+          throw invalid_identifier("Unknown room.");
+        }
+        Room& room = *it->second;
+        switch (message.type) {
+          case RoomManager::JOIN_ROOM :
+            deal(room, message.id);
+            room.roster.push_back(message.id);
+            break;
+          case RoomManager::STEP_ROOM :
+            room.game.completeNextCall(room.out);
+            if (room.game.getNumPlayers() == 0) {
+              reply.gameOver = true;
+              for (const std::string& id : room.roster) {
+                deal(room, id);
+              }
+            }
+            reply.text = room.out.str();
+            room.out.str("");
+            break;
+          case RoomManager::CLOSE_ROOM :
+            _rooms.erase(it);
+            break;
+          default :
+            throw function_unavailable("This is not a room message.");
+        }
+      }
+    } catch (const std::exception& e) {
+      reply.ok = false;
+      reply.text = e.what();
+    }
+    reply.done = std::chrono::steady_clock::now();
+    while (!_outbox.push(reply)) {
+      if (_stopping.load(std::memory_order_relaxed)) {
+        return;
+      }
+      std::this_thread::yield();
+    }
+  }
+
+  /**
+  * @brief Make a card for a player and join the room's game with it.
+  * @param [in] room The room.
+  * @param [in] id The player id.
+  * @throw invalid_identifier If the player is already in the room.
+  */
+  void deal(Room& room, const std::string& id) {
+    BingoCard* card = _factory.makeBingoCard(room.caller->getGameType(),
+                                             &room.condition);
+    if (!room.game.joinGame(id, card)) {
+      delete card;
+      throw invalid_identifier("The player is already in the room.");
+    }
+  }
+};
+
+RoomManager::RoomManager(unsigned numShards, unsigned queueSize)
+  : _nextRoom{0} {
+  if (numShards == 0) {
+    numShards = std::thread::hardware_concurrency();
+  }
+  if (numShards == 0) {
+    numShards = 1;
+  }
+  for (unsigned i = 0; i < numShards; ++i) {
+    _shards.emplace_back(new RoomShard(i, queueSize));
+  }
+}
+
+RoomManager::~RoomManager() {
+  for (auto& shard : _shards) {
+    shard->stop();
+  }
+  for (unsigned i = 0; i < _shards.size(); ++i) {
+    send(STOP_SHARD, i);
+  }
+  for (auto& shard : _shards) {
+    shard->join();
+  }
+}
+
+unsigned RoomManager::getNumShards() {
+  return _shards.size();
+}
+
+unsigned RoomManager::getShard(unsigned long room) {
+  return room % _shards.size();
+}
+
+unsigned long RoomManager::createRoom(BingoTypes::gameType game,
+                                      BingoTypes::victoryType victory,
+                                      bool autoDaub) {
+  unsigned long room = _nextRoom++;
+  send(CREATE_ROOM, room, game, victory, autoDaub);
+  return room;
+}
+
+void RoomManager::joinRoom(unsigned long room, std::string id) {
+  send(JOIN_ROOM, room, BingoTypes::BINGO75, BingoTypes::HORIZONTAL_LINE,
+       true, std::move(id));
+}
+
+void RoomManager::stepRoom(unsigned long room) {
+  send(STEP_ROOM, room);
+}
+
+void RoomManager::closeRoom(unsigned long room) {
+  send(CLOSE_ROOM, room);
+}
+
+unsigned RoomManager::poll(std::vector<roomReply>& replies) {
+  unsigned count = _pending.size();
+  for (roomReply& reply : _pending) {
+    replies.push_back(std::move(reply));
+  }
+  _pending.clear();
+  return count + drain(replies);
+}
+
+void RoomManager::send(messageType type, unsigned long room,
+                       BingoTypes::gameType game,
+                       BingoTypes::victoryType victory, bool autoDaub,
+                       std::string id) {
+  roomMessage message{type, room, game, victory, autoDaub, std::move(id),
+    std::chrono::steady_clock::now()};
+  SpscQueue<roomMessage>& inbox = _shards[getShard(room)]->inbox();
+  while (!inbox.push(message)) {
+    drain(_pending);
+    std::this_thread::yield();
+  }
+}
+
+unsigned RoomManager::drain(std::vector<roomReply>& replies) {
+  unsigned count = 0;
+  roomReply reply;
+  for (auto& shard : _shards) {
+    while (shard->outbox().pop(reply)) {
+      replies.push_back(std::move(reply));
+      ++count;
+    }
+  }
+  return count;
+}
@@ -0,0 +1,155 @@
+
+#ifndef ROOM_MANAGER_H_INCLUDED
+#define ROOM_MANAGER_H_INCLUDED
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "BingoTypes.h"
+
+class RoomShard;
+
+/**
+* @class RoomManager RoomManager.h "RoomManager.h"
+* @brief Hosts many bingo rooms on a thread per core runtime.
+* @details Each room is a BingoGame with its own caller, and is pinned to
+*   one shard, a worker thread that owns every object of its rooms. The
+*   manager never touches a room: it sends messages to the room's shard
+*   over a lock free single producer queue, and the shard sends back a
+*   roomReply for each one. BingoGame stays single threaded and no lock is
+*   shared between threads. A room keeps its roster of players and deals
+*   them fresh cards when a game ends, so it plays game after game.
+*
+*   The manager itself is not thread safe, all of its methods are called
+*   from the thread that created it.
+*/
+class RoomManager {
+ public:
+  enum messageType {CREATE_ROOM = 1, JOIN_ROOM, STEP_ROOM, CLOSE_ROOM,
+    STOP_SHARD};
+
+  /**
+  * @brief The answer of a shard to one message.
+  */
+  struct roomReply {
+    unsigned long room;
+    messageType type;
+    /**< false if the message failed, error then holds the reason. >**/
+    bool ok;
+    /**< true if a STEP_ROOM ended the game. >**/
+    bool gameOver;
+    /**< What the room wrote to its players, or the error. >**/
+    std::string text;
+    std::chrono::steady_clock::time_point sent;
+    std::chrono::steady_clock::time_point done;
+  };
+
+  /**
+  * @brief Constructor, starts the shards.
+  * @param [in] numShards The number of worker threads, 0 for one per
+  *   core.
+  * @param [in] queueSize The number of messages each shard's queues hold.
+  */
+  explicit RoomManager(unsigned numShards = 0, unsigned queueSize = 4096);
+
+  /**
+  * @brief Copy constructor, disabled.
+  * @param rv a RoomManager class object.
+  */
+  RoomManager(const RoomManager& rv) = delete;
+
+  /**
+  * @brief Assignment operator, disabled.
+  * @param rv a RoomManager class object.
+  */
+  void operator=(const RoomManager& rv) = delete;
+
+  /**
+  * @brief Destructor, stops the shards, the open rooms are torn down.
+  */
+  virtual ~RoomManager();
+
+  /**
+  * @brief Access the number of shards.
+  * @return The number of worker threads.
+  */
+  unsigned getNumShards();
+
+  /**
+  * @brief The shard a room is pinned to.
+  * @param [in] room A room id.
+  * @return The index of the room's shard.
+  */
+  unsigned getShard(unsigned long room);
+
+  /**
+  * @brief Open a room.
+  * @param [in] game The game type of the room.
+  * @param [in] victory The victory type of the room.
+  * @param [in] autoDaub true if the room daubs called balls for its
+  *   players, see BingoGame::setAutoDaub.
+  * @return The id of the new room.
+  */
+  unsigned long createRoom(BingoTypes::gameType game,
+                           BingoTypes::victoryType victory,
+                           bool autoDaub = true);
+
+  /**
+  * @brief Add a player to a room, the shard deals the player a card.
+  * @param [in] room The id of the room.
+  * @param [in] id The id of the player.
+  */
+  void joinRoom(unsigned long room, std::string id);
+
+  /**
+  * @brief Play the next call of a room, see BingoGame::completeNextCall.
+  * @param [in] room The id of the room.
+  */
+  void stepRoom(unsigned long room);
+
+  /**
+  * @brief Tear down a room.
+  * @param [in] room The id of the room.
+  */
+  void closeRoom(unsigned long room);
+
+  /**
+  * @brief Collect the replies that have arrived.
+  * @param [out] replies The replies are appended to it.
+  * @return The number of replies appended.
+  */
+  unsigned poll(std::vector<roomReply>& replies);
+
+ private:
+  std::vector<std::unique_ptr<RoomShard>> _shards;
+  unsigned long _nextRoom;
+  /**< Replies drained while waiting for room in a full queue. >**/
+  std::vector<roomReply> _pending;
+
+  /**
+  * @brief Send a message to the shard of a room.
+  * @details If the shard's queue is full, replies are drained into
+  *   _pending until there is room, so neither side can wait on the other.
+  * @param [in] type The message type.
+  * @param [in] room The room id.
+  * @param [in] game The game type, for CREATE_ROOM.
+  * @param [in] victory The victory type, for CREATE_ROOM.
+  * @param [in] autoDaub The auto daub mode, for CREATE_ROOM.
+  * @param [in] id The player id, for JOIN_ROOM.
+  */
+  void send(messageType type, unsigned long room,
+            BingoTypes::gameType game = BingoTypes::BINGO75,
+            BingoTypes::victoryType victory = BingoTypes::HORIZONTAL_LINE,
+            bool autoDaub = true, std::string id = "");
+
+  /**
+  * @brief Move the replies of every shard into replies.
+  * @param [out] replies The replies are appended to it.
+  * @return The number of replies appended.
+  */
+  unsigned drain(std::vector<roomReply>& replies);
+};
+
+#endif // ROOM_MANAGER_H_INCLUDED
@@ -10,6 +10,7 @@
 #include "Square.h"
 #include "BingoTypes.h"
 #include "BingoCard.h"
+#include "WinPatterns.h"
 
 #include "Exceptions.h"
 
@@ -18,17 +19,17 @@ ScreenDisplay::ScreenDisplay() {}
 ScreenDisplay::~ScreenDisplay() {}
 
 void ScreenDisplay::displayGrid(std::ostream& out,
-                                const std::vector<Square*>& grid) {
+                                const BingoCard::gridType& grid) {
   drawBingoCardTop(out, ScreenDisplay::COL_WIDTH);
 
-  for (unsigned i = 0; i < 5; ++i) {
+  for (unsigned i = 0; i < WinPatterns::NUM_ROWS; ++i) {
     out << '|';
-    for (unsigned k = 0; k < 5; ++k) {
-      std::string displaySqu = grid[i + 5 * k]->toString();
+    for (unsigned k = 0; k < WinPatterns::NUM_COLS; ++k) {
+      std::string displaySqu = grid[WinPatterns::location(i, k)].toString();
       unsigned gap = (ScreenDisplay::COL_WIDTH - displaySqu.size()) / 2;
       out << std::setw(gap + displaySqu.size())
           << std::right << displaySqu;
-      if ((grid[i + 5 * k]->getDaubState())->isCorrect()) {
+      if ((grid[WinPatterns::location(i, k)].getDaubState())->isCorrect()) {
         out << std::setw(gap + 1) << std::right
             << '|';
       } else {
@@ -46,9 +47,9 @@ void ScreenDisplay::displayGrid(std::ostream& out,
 void ScreenDisplay::displayValidity(std::ostream& out, BingoCard* card) {
   drawBingoCardTop(out, ScreenDisplay::COL_WIDTH);
 
-  for (unsigned i = 1; i <= 5; ++i) {
+  for (unsigned i = 1; i <= WinPatterns::NUM_ROWS; ++i) {
     out << '|';
-    for (unsigned k = 1; k <= 5; ++k) {
+    for (unsigned k = 1; k <= WinPatterns::NUM_COLS; ++k) {
       BingoTypes::squarePos pos;
       pos.row = i;
       pos.col = k;
@@ -72,9 +73,9 @@ void ScreenDisplay::displayValidity(std::ostream& out, BingoCard* card) {
 void ScreenDisplay::displayBingoCard(std::ostream& out, BingoCard* card) {
   drawBingoCardTop(out, ScreenDisplay::COL_WIDTH);
 
-  for (unsigned i = 1; i <= 5; ++i) {
+  for (unsigned i = 1; i <= WinPatterns::NUM_ROWS; ++i) {
     out << '|';
-    for (unsigned k = 1; k <= 5; ++k) {
+    for (unsigned k = 1; k <= WinPatterns::NUM_COLS; ++k) {
       BingoTypes::squarePos pos;
       pos.row = i;
       pos.col = k;
@@ -110,7 +111,12 @@ void ScreenDisplay::displayGameBoard(std::ostream& out, BingoCaller* caller) {
   if (caller == nullptr) {
     throw bad_input("Cannot display game board without a valied caller.");
   }
-  out << caller->listPulledBalls() << '\n';
+  BoardView board = caller->getBoard();
+  if (board.getText().empty()) {
+    out << caller->listPulledBalls() << '\n';
+  } else {
+    out << board.getText() << '\n';
+  }
 }
 
 void ScreenDisplay::displayGameInstructions(std::ostream& out,
@@ -199,19 +205,19 @@ void ScreenDisplay::displayPlayerIdPrompt(std::ostream& out,
 }
 
 void ScreenDisplay::displayValidityCheck(std::ostream& out,
-                                         const std::vector<Square*>& grid) {
+                                         const BingoCard::gridType& grid) {
   out << "Daubing errors are marked with an x.\n";
 
   drawBingoCardTop(out, ScreenDisplay::COL_WIDTH);
 
-  for (unsigned i = 0; i < 5; ++i) {
+  for (unsigned i = 0; i < WinPatterns::NUM_ROWS; ++i) {
     out << '|';
-    for (unsigned k = 0; k < 5; ++k) {
-      std::string displaySqu = grid[i + 5 * k]->toString();
+    for (unsigned k = 0; k < WinPatterns::NUM_COLS; ++k) {
+      std::string displaySqu = grid[WinPatterns::location(i, k)].toString();
       unsigned gap = (ScreenDisplay::COL_WIDTH - displaySqu.size()) / 2;
       out << std::setw(gap + displaySqu.size())
           << std::right << displaySqu;
-      if (grid[i + 5 * k]->getDaubState()->isCorrect())
+      if (grid[WinPatterns::location(i, k)].getDaubState()->isCorrect())
         out << std::setw(gap + 1) << std::right << '|';
       else
         out << 'x' << std::setw(gap) << std::right << '|';
@@ -273,28 +279,7 @@ std::string ScreenDisplay::victoryToString(BingoTypes::victoryType victory) {
 
 std::string ScreenDisplay::victoryToDescription
   (BingoTypes::victoryType victory) {
-  VictoryCondition* victoryCondition;
-
-  switch (victory) {
-    case BingoTypes::HORIZONTAL_LINE:
-      victoryCondition = new HorizontalLine();
-      break;
-    case BingoTypes::VERTICAL_LINE:
-      victoryCondition = new VerticalLine();
-      break;
-    case BingoTypes::ANY_LINE:
-      victoryCondition = new AnyLine();
-      break;
-    case BingoTypes::BLACKOUT:
-      victoryCondition = new Blackout();
-      break;
-    default:
-      return "Not defined";
-  }
-  std::string desc = victoryCondition->getDescription();
-  delete victoryCondition;
-
-  return desc;
+  return WinPatterns::patterns(victory).description;
 }
 
 std::string ScreenDisplay::moveToString(BingoTypes::moveType playerMove) {
@@ -323,7 +308,7 @@ std::string ScreenDisplay::moveToString(BingoTypes::moveType playerMove) {
 void ScreenDisplay::drawHorizontalBorder(std::ostream& out,
                                          unsigned colWidth) {
   out << '+' << std::setfill('-');
-  for (unsigned i = 0; i < 5; ++i) {
+  for (unsigned i = 0; i < WinPatterns::NUM_COLS; ++i) {
     out << std::setw(colWidth + 1) << std::right << '+';
   }
   out << std::setfill(' ');
@@ -331,7 +316,7 @@ void ScreenDisplay::drawHorizontalBorder(std::ostream& out,
 
 void ScreenDisplay::drawBingoCardTop(std::ostream& out, unsigned colWidth) {
     out << '+';
-    for (unsigned i = 0; i < 5; ++i) {
+    for (unsigned i = 0; i < WinPatterns::NUM_COLS; ++i) {
         out << std::setfill('-') << std::setw(colWidth + 1) << std::right << '+';
     }
     out << std::setfill(' ');
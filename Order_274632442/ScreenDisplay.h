@@ -37,8 +37,7 @@ class ScreenDisplay {
    * @param [inout] out Insert to this input stream.
    * @param [in] grid A grid of squares.
    */
-  void displayGrid(std::ostream& out,
-                   const std::vector<Square*>& grid);
+  void displayGrid(std::ostream& out, const BingoCard::gridType& grid);
 
   /**
    * @brief Display a the bingo card, showing the squares' states.
@@ -142,7 +141,7 @@ class ScreenDisplay {
    * @param [in] grid A grid of squares.
    */
   void displayValidityCheck(std::ostream& out,
-                            const std::vector<Square*>& grid);
+                            const BingoCard::gridType& grid);
 
   /**
    * @brief Display a string representation of the game's type.
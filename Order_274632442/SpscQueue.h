@@ -0,0 +1,106 @@
+
+#ifndef SPSC_QUEUE_H_INCLUDED
+#define SPSC_QUEUE_H_INCLUDED
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+/**
+* @class SpscQueue SpscQueue.h "SpscQueue.h"
+* @brief A bounded lock free queue for one producer thread and one consumer
+*   thread.
+* @details The slots form a ring of a power of two size. The producer only
+*   writes _tail and the consumer only writes _head, each on its own cache
+*   line, and each side keeps a cached copy of the other's index so it only
+*   reads the shared one when the ring looks full or empty.
+* @tparam T The item type, default constructible and move assignable.
+*/
+template <typename T>
+class SpscQueue {
+ public:
+  /**
+  * @brief Constructor.
+  * @param [in] capacity The least number of items the queue can hold, it
+  *   is rounded up to a power of two.
+  */
+  explicit SpscQueue(std::size_t capacity)
+    : _mask{roundUp(capacity) - 1}, _slots{new T[_mask + 1]},
+      _head{0}, _tailCache{0}, _tail{0}, _headCache{0} {}
+
+  /**
+  * @brief Copy constructor, disabled.
+  * @param rv a SpscQueue class object.
+  */
+  SpscQueue(const SpscQueue& rv) = delete;
+
+  /**
+  * @brief Assignment operator, disabled.
+  * @param rv a SpscQueue class object.
+  */
+  void operator=(const SpscQueue& rv) = delete;
+
+  /**
+  * @brief Add an item, only called by the producer.
+  * @param [in] item The item, moved from only if it is added.
+  * @return true, if the item is added, false if the queue is full.
+  */
+  bool push(T& item) {
+    std::size_t tail = _tail.load(std::memory_order_relaxed);
+    if (tail - _headCache > _mask) {
+      _headCache = _head.load(std::memory_order_acquire);
+      if (tail - _headCache > _mask) {
+        return false;
+      }
+    }
+    _slots[tail & _mask] = std::move(item);
+    _tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+  * @brief Remove the oldest item, only called by the consumer.
+  * @param [out] item Where the item is moved to.
+  * @return true, if an item is removed, false if the queue is empty.
+  */
+  bool pop(T& item) {
+    std::size_t head = _head.load(std::memory_order_relaxed);
+    if (head == _tailCache) {
+      _tailCache = _tail.load(std::memory_order_acquire);
+      if (head == _tailCache) {
+        return false;
+      }
+    }
+    item = std::move(_slots[head & _mask]);
+    _head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+ private:
+  static const std::size_t CACHE_LINE = 64;
+
+  std::size_t _mask;
+  std::unique_ptr<T[]> _slots;
+  /**< The consumer's side. >**/
+  alignas(CACHE_LINE) std::atomic<std::size_t> _head;
+  std::size_t _tailCache;
+  /**< The producer's side. >**/
+  alignas(CACHE_LINE) std::atomic<std::size_t> _tail;
+  std::size_t _headCache;
+
+  /**
+  * @brief The least power of two at least n.
+  * @param [in] n The capacity asked for.
+  * @return The capacity of the ring, at least 2.
+  */
+  static std::size_t roundUp(std::size_t n) {
+    std::size_t size = 2;
+    while (size < n) {
+      size *= 2;
+    }
+    return size;
+  }
+};
+
+#endif // SPSC_QUEUE_H_INCLUDED
@@ -1,82 +1,71 @@
-
-#include <iostream>
+#include <string>
 
 #include "Square.h"
+#include "BingoTypes.h"
 #include "DaubState.h"
-
-Square::Square(unsigned value) : _value{value} {}
-
-Square::~Square() {
-  delete _daubed;
+#include "Exceptions.h"
+
+Square::Square(unsigned value)
+  : _value{static_cast<unsigned char>(value)}, _state{NO_DAUB},
+    _isFree{false} {
+  // The value is kept in a byte and indexes the ball masks.
+  if (value >= BingoTypes::MAX_BALLS) {
+    throw bad_input("A square's value must be less than the number of balls"
+                    " a game can have.");
+  }
 }
 
-unsigned Square::getValue() {
-  return _value;
+DaubState* Square::getDaubState() const {
+  switch (_state) {
+    case GOOD_DAUB:
+      return GoodDaub::getInstance();
+    case BAD_DAUB:
+      return BadDaub::getInstance();
+    case NEEDS_DAUB:
+      return NeedsDaub::getInstance();
+    default:
+      return NoDaub::getInstance();
+  }
 }
 
-DaubState* Square::getDaubState() {
-  return _daubed;
-}
-
-FreeSquare::FreeSquare(unsigned value) : Square(0) {
-  _daubed = new GoodDaub();
-}
-
-FreeSquare::~FreeSquare() {}
-
-bool FreeSquare::daubSquare(unsigned numberCalled) {
-  return false;
-}
-
-void FreeSquare::shouldDaubSquare(unsigned numberCalled) {}
-
-void FreeSquare::resetSquare() {}
+bool Square::daubSquare(unsigned numberCalled) {
+  if (_state == GOOD_DAUB || _state == BAD_DAUB)
+    return false;
 
-std::string FreeSquare::toString() {
-  return "free";
+  _state = (_value == numberCalled) ? GOOD_DAUB : BAD_DAUB;
+  return true;
 }
 
-IntSquare::IntSquare(unsigned value) : Square{value} {
-  _daubed = new NoDaub();
+void Square::shouldDaubSquare(unsigned numberCalled) {
+  if (_value == numberCalled && !_isFree && _state == NO_DAUB) {
+    _state = NEEDS_DAUB;
+  }
 }
 
-IntSquare::~IntSquare() {}
-
-bool IntSquare::daubSquare(unsigned numberCalled) {
-    if (_value == numberCalled) {
-        _daubed = new GoodDaub();
-        return true;
-    }
-    return false;
+void Square::resetSquare() {
+  _state = _isFree ? GOOD_DAUB : NO_DAUB;
 }
 
-void IntSquare::shouldDaubSquare(unsigned numberCalled) {
-    if (_value == numberCalled) {
-        _daubed->daub();
-    }
-}
+std::string Square::toString() const {
+  if (_isFree)
+    return "free";
 
-void IntSquare::resetSquare() {
-  delete _daubed;
-  _daubed = new NoDaub();
-}
-
-std::string IntSquare::toString() {
-  std::string display = "";
-  if (_daubed->isDaubed())
-    display = "(";
-  else
-    display = " ";
+  bool daubed = (_state == GOOD_DAUB || _state == BAD_DAUB);
+  std::string display = daubed ? "(" : " ";
 
   if (_value < 10)
     display += "0" + std::to_string(_value);
   else
     display += std::to_string(_value);
 
-  if (_daubed->isDaubed())
-    display += ")";
-  else
-    display += " ";
+  display += daubed ? ")" : " ";
 
   return display;
 }
+
+FreeSquare::FreeSquare(unsigned) : Square{0} {
+  _state = GOOD_DAUB;
+  _isFree = true;
+}
+
+IntSquare::IntSquare(unsigned value) : Square{value} {}
@@ -1,157 +1,125 @@
-
 #ifndef SQUARE_H_INCLUDED
 #define SQUARE_H_INCLUDED
 
 #include <string>
+#include <type_traits>
 
 #include "DaubState.h"
 
 /**
 * @class Square Square.h "Square.h"
-* @brief Abstract superclass for bingo card squares.
+* @brief One square of a bingo card, a small trivially copyable value.
+* @details A square is its value, its daub state and whether it is the free
+*   square, so a card can hold its squares inline and be copied with memcpy.
 */
 class Square {
  public:
+  /**< The possible outcomes of daubing a square, see DaubState. >**/
+  enum daubState : unsigned char {NO_DAUB, GOOD_DAUB, BAD_DAUB, NEEDS_DAUB};
+
   /**
-  * @brief Default constructor, initializes _daubed to NoDaub.
+  * @brief Default constructor, initializes the state to NO_DAUB.
   * @param [in] value the numeric value of the square.
+  * @throw bad_input If value is not less than BingoTypes::MAX_BALLS.
   */
   Square(unsigned value = 0);
 
   /**
-  * @brief Destructor, deallocates _daubed.
+  * @brief Returns the numeric value of the square.
+  * @return The unsigned numeric value of the square, 0 for the free square.
   */
-  virtual ~Square();
+  unsigned getValue() const {
+    return _value;
+  }
 
   /**
-  * @brief Returns the numeric value of the square.
-  * @return The unsigned numeric value of the square.
+  * @brief Determines if this is the free square.
+  * @return true, if this is the free square, false otherwise.
   */
-  unsigned getValue();
+  bool isFree() const {
+    return _isFree;
+  }
 
   /**
-  * @brief Gives access to this square's _daubed.
-  * @return A pointer to this square's _daubed.
+  * @brief Access the daub state of the square.
+  * @return The daubState of the square.
   */
-  DaubState* getDaubState();
+  daubState getState() const {
+    return _state;
+  }
 
   /**
-  * @brief May reset _daubed based on the square type, numberCalled and _value.
+  * @brief Gives access to the shared DaubState for this square's state.
+  * @return A pointer to the shared DaubState, it must not be deleted.
+  */
+  DaubState* getDaubState() const;
+
+  /**
+  * @brief Sets the state based on numberCalled and _value.
+  * @details If numberCalled is the same as _value then the state is set to
+  *   GOOD_DAUB, if they do not match it is set to BAD_DAUB. The free square
+  *   is always GOOD_DAUB and is not changed.
   * @param [in] numberCalled The number called by the BingoCaller.
-  * @return true, if previously isDaubed was false and now it is true.
+  * @return true, if the square was not previously daubed, false otherwise.
   */
-  virtual bool daubSquare(unsigned numberCalled) = 0;
+  bool daubSquare(unsigned numberCalled);
 
   /**
-  * @brief May reset _daubed based on the square type, numberCalled and _value.
+  * @brief Sets the state appropriately based on the numberCalled and _value.
+  * @details If numberCalled is the same as _value and this square
+  *   is not currently daubed then the state is set to NEEDS_DAUB.
+  *   Otherwise, the state is not changed.
   * @param [in] numberCalled The number called by the BingoCaller.
   */
-  virtual void shouldDaubSquare(unsigned numberCalled) = 0;
+  void shouldDaubSquare(unsigned numberCalled);
 
   /**
-  * @brief Reset _daubed to initial state.
+  * @brief Reset the state to NO_DAUB, or GOOD_DAUB for the free square.
   */
-  virtual void resetSquare() = 0;
+  void resetSquare();
 
   /**
-  * @brief Creates a string representation of the Square's value and state.
-  * @return Returns a string representation of the Square's value and state.
+   * @brief Creates a string representation of the square for output.
+   * @details Numbers are always return in two digits, if this square is
+   *   daubed, then the number is enclosed in braces. The free square is
+   *   shown as "free".
+  * @return Returns a string representation of the Square's value for output.
   */
-  virtual std::string toString() = 0;
+  std::string toString() const;
 
  protected:
-  unsigned _value;
-  DaubState* _daubed;
+  unsigned char _value;
+  daubState _state;
+  bool _isFree;
 };
 
 /**
 * @class FreeSquare Square.h "Square.h"
-* @brief Implements the free square of a bingo card.
+* @brief Makes the free square of a bingo card.
 */
 class FreeSquare : public Square {
  public:
   /**
-  * @brief Default constructor, initializes _value to 0, _daubed to GoodDaub.
+  * @brief Default constructor, initializes _value to 0, state to GOOD_DAUB.
   */
   FreeSquare(unsigned value = 0);
-
-  /**
-  * @brief Destructor, doesn't deallocate _daubed because Square does that.
-  */
-  virtual ~FreeSquare();
-
-  /**
-  * @brief Doesn't change _daubed, because _doubed is always a GoodDaub pointer.
-  * @param [in] numberCalled The number called by the BingoCaller.
-  * @return true, always
-  */
-  bool daubSquare(unsigned numberCalled);
-
-  /**
-  * @brief Doesn't change _daubed, because _doubed is always a GoodDaub pointer.
-  * @param [in] numberCalled The number called by the BingoCaller.
-  */
-  void shouldDaubSquare(unsigned numberCalled);
-
-  /**
-  * @brief Doesn't change _daubed, because _daubed is always a GoodDaub pointer.
-  */
-  void resetSquare();
-
-  /**
-  * @brief Returns the string "free"
-  * @return Returns the string "free"
-  */
-  std::string toString();
 };
 
 /**
 * @class IntSquare Square.h "Square.h"
-* @brief Implements one square of a bingo game.
+* @brief Makes a numbered square of a bingo card.
 */
 class IntSquare : public Square {
  public:
   /**
-  * @brief Default constructor, initializes _daubed to NoDaub.
+  * @brief Default constructor, initializes the state to NO_DAUB.
   * @param [in] value the numeric value of the square.
+  * @throw bad_input If value is not less than BingoTypes::MAX_BALLS.
   */
   IntSquare(unsigned value = 0);
-
-  /**
-  * @brief Destructor, doesn't deallocate _daubed because Square does that.
-  */
-  virtual ~IntSquare();
-
-  /**
-  * @brief Sets _daubed based on the numberCalled and _value.
-  * @details If numberCalled is the same as _value then _daubed is set to GoodDaub.
-  *   However, if they do not match, then _daubed is set to BadDaub.
-  * @param [in] numberCalled The number called by the BingoCaller.
-  * @return true, if the square was not previously daubed, false otherwise.
-  */
-  bool daubSquare(unsigned numberCalled);
-
-  /**
-  * @brief Sets _daubed appropriately based on the numberCalled and _value.
-  * @details If numberCalled is the same as _value and this square
-  *   is not currently daubed then _daubed is set to NeedsDaub.
-  *   Otherwise, _daubed is not changed.
-  * @param [in] numberCalled The number called by the BingoCaller.
-  */
-  void shouldDaubSquare(unsigned numberCalled);
-
-  /**
-  * @brief Deletes the previous _daubed, then sets _daubed to NoDaub.
-  */
-  void resetSquare();
-
-  /**
-   * @brief Creates a string representation of the square for output.
-   * @details Numbers are always return in two digits, if this square is daubed,
-   *   then the number is enclosed in braces.
-  * @return Returns a string representation of the Square's value for output.
-  */
-  std::string toString();
 };
 
+static_assert(std::is_trivially_copyable<Square>::value,
+              "Squares are stored inline in cards and copied with memcpy");
+
 #endif // SQUARE_H_INCLUDED
@@ -3,6 +3,7 @@
 
 #include "UserInput.h"
 #include "BingoTypes.h"
+#include "WinPatterns.h"
 #include "Exceptions.h"
 
 UserInput::UserInput() {}
@@ -80,13 +81,13 @@ BingoTypes::squarePos UserInput::getSquarePosition(std::istream& in) {
   BingoTypes::squarePos pos;
 
   in >> pos.row;
-  if (in.fail() || pos.row < 1 || pos.row > 5) {
+  if (in.fail() || pos.row < 1 || pos.row > WinPatterns::NUM_ROWS) {
     throw bad_input
     ("Did not read expected numeric value for row in the range [1, 5].");
   }
 
   in >> pos.col;
-  if (in.fail() || pos.col < 1 || pos.col > 5) {
+  if (in.fail() || pos.col < 1 || pos.col > WinPatterns::NUM_COLS) {
     throw bad_input
     ("Did not read expected numeric value for col in the range [1, 5].");
   }
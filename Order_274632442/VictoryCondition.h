@@ -1,26 +1,27 @@
-
 #ifndef VICTORY_CONDITION_H_INCLUDED
 #define VICTORY_CONDITION_H_INCLUDED
 
+#include <array>
 #include <string>
-#include <vector>
 
 #include "Square.h"
 #include "BingoTypes.h"
+#include "WinPatterns.h"
 
 /**
 * @class VictoryCondition VictoryCondition.h "VictoryCondition.h"
-* @brief Interface for bingo victory conditions.
+* @brief A bingo victory condition, backed by the WinPatterns mask table.
+* @details The subclasses only name the victory type, all of them are
+*   answered by testing the card's daub mask against the table, so no
+*   virtual dispatch is needed when checking a card.
 */
 class VictoryCondition {
  public:
   /**
   * @brief Constructor.
-  * @param [in] description Description of the victory condition suitable to
-  *   be shared with players.
   * @param [in] victory A victory type.
   */
-  VictoryCondition(std::string description, BingoTypes::victoryType victory);
+  explicit VictoryCondition(BingoTypes::victoryType victory);
 
   /**
   * @brief Destructor
@@ -29,7 +30,8 @@ class VictoryCondition {
 
   /**
   * @brief Access the _description.
-  * @return The description of the victory condition.
+  * @return The description of the victory condition suitable to be shared
+  *   with players.
   */
   std::string getDescription();
 
@@ -41,21 +43,25 @@ class VictoryCondition {
 
   /**
   * @brief Examines the grid to determine if the card has won.
+  * @details Builds the daub mask of the grid, see hasWon(unsigned).
   * @param [in] grid The squares of a bingo card.
   * @return true, if the victory condition is met, false otherwise.
   */
-  virtual bool hasWon(std::vector<Square*> grid) = 0;
+  bool hasWon(const std::array<Square, WinPatterns::NUM_SQUARES>& grid);
 
- protected:
-  std::string _description;
-  BingoTypes::victoryType _victoryType;
   /**
-  * @brief Determines if all the Squares in squares are daubed and correct.
-  * @param [in] squares The squares to be checked.
-  * @return false, if any of the squares are not daubed or not correct,
-  *   true otherwise.
+  * @brief Examines a card's daub mask to determine if the card has won.
+  * @details Bit WinPatterns::location(row, col) of daubMask is set when
+  *   that square is daubed and correct.
+  * @param [in] daubMask The correctly daubed squares of a bingo card.
+  * @return true, if the victory condition is met, false otherwise.
   */
-  bool checkSquareSet(std::vector<Square*> squares);
+  bool hasWon(unsigned daubMask) {
+    return WinPatterns::hasWon(_victoryType, daubMask);
+  }
+
+ protected:
+  BingoTypes::victoryType _victoryType;
 };
 
 /**
@@ -66,7 +72,7 @@ class VictoryCondition {
 class HorizontalLine : public VictoryCondition {
  public:
   /**
-  * @brief Default constructor, set _victoryType and description.
+  * @brief Default constructor, set _victoryType.
   */
   HorizontalLine();
 
@@ -74,15 +80,6 @@ class HorizontalLine : public VictoryCondition {
   * @brief Destructor
   */
   virtual ~HorizontalLine();
-
-  /**
-  * @brief Examines the grid to determine if the card has won.
-  * @details Determines if any horizontal line of the bingo card has Squares
-  *   that are all daubed and correct.
-  * @param [in] grid The squares of a bingo card.
-  * @return true, if the victory condition is met, false otherwise.
-  */
-  bool hasWon(std::vector<Square*> grid);
 };
 
 /**
@@ -93,7 +90,7 @@ class HorizontalLine : public VictoryCondition {
 class VerticalLine : public VictoryCondition {
  public:
   /**
-  * @brief Default constructor, set _victoryType and description.
+  * @brief Default constructor, set _victoryType.
   */
   VerticalLine();
 
@@ -101,15 +98,6 @@ class VerticalLine : public VictoryCondition {
   * @brief Destructor
   */
   virtual ~VerticalLine();
-
-  /**
-  * @brief Examines the grid to determine if the card has won.
-  * @details Determines if any vertical line of the bingo card has Squares
-  *   that are all daubed and correct.
-  * @param [in] grid The squares of a bingo card.
-  * @return true, if the victory condition is met, false otherwise.
-  */
-  bool hasWon(std::vector<Square*> grid);
 };
 
 /**
@@ -120,7 +108,7 @@ class VerticalLine : public VictoryCondition {
 class AnyLine : public VictoryCondition {
  public:
   /**
-  * @brief Default constructor, set _victoryType and description.
+  * @brief Default constructor, set _victoryType.
   */
   AnyLine();
 
@@ -128,15 +116,6 @@ class AnyLine : public VictoryCondition {
   * @brief Destructor
   */
   virtual ~AnyLine();
-
-  /**
-  * @brief Examines the grid to determine if the card has won.
-  * @details Determines if any line, vertical, horizontal, or diagonal of the
-  *   bingo card has five Squares that are all daubed and correct.
-  * @param [in] grid The squares of a bingo card.
-  * @return true, if the victory condition is met, false otherwise.
-  */
-  bool hasWon(std::vector<Square*> grid);
 };
 
 /**
@@ -146,7 +125,7 @@ class AnyLine : public VictoryCondition {
 class Blackout : public VictoryCondition {
  public:
   /**
-  * @brief Default constructor, set _victoryType and description.
+  * @brief Default constructor, set _victoryType.
   */
   Blackout();
 
@@ -154,13 +133,5 @@ class Blackout : public VictoryCondition {
   * @brief Destructor
   */
   virtual ~Blackout();
-
-  /**
-  * @brief Examines the grid to determine if the card has won.
-  * @details Determines if all Squares are daubed and correct.
-  * @param [in] grid The squares of a bingo card.
-  * @return true, if the victory condition is met, false otherwise.
-  */
-  bool hasWon(std::vector<Square*> grid);
 };
 #endif // VICTORY_CONDITION_H_INCLUDED
@@ -0,0 +1,199 @@
+#ifndef WIN_PATTERNS_H_INCLUDED
+#define WIN_PATTERNS_H_INCLUDED
+
+#include <array>
+
+#include "BingoTypes.h"
+
+/**
+* @class BasicWinPatterns WinPatterns.h "WinPatterns.h"
+* @brief Compile time table of the square masks that win a bingo game on a
+*   Rows x Cols card.
+* @details This is the one place that defines how a square's (row, col)
+*   maps to its location on a bingo card. Squares are stored column by
+*   column, location = Rows * col + row for a zero based row and col, which
+*   is the order BingoCardFactory builds the columns in. Bit location of a
+*   daub mask represents that square. Square cards also win on the two
+*   diagonals.
+*/
+template <unsigned Rows, unsigned Cols, unsigned FreeIndex>
+class BasicWinPatterns {
+ public:
+  static const unsigned NUM_ROWS = Rows;
+  static const unsigned NUM_COLS = Cols;
+  static const unsigned NUM_SQUARES = Rows * Cols;
+  static const unsigned FREE_LOCATION = FreeIndex;
+  static const unsigned NUM_DIAGONALS = (Rows == Cols) ? 2 : 0;
+  /**< Masks in the table: rows, columns, diagonals and blackout. >**/
+  static const unsigned NUM_MASKS = Rows + Cols + NUM_DIAGONALS + 1;
+
+  static_assert(NUM_SQUARES <= 32, "a daub mask is an unsigned");
+  static_assert(FreeIndex < NUM_SQUARES, "the free square is on the card");
+
+  /**
+  * @brief The range of MASKS a victory type is won by.
+  */
+  struct PatternSet {
+    unsigned first;
+    unsigned count;
+    const char* description;
+  };
+
+  /**
+  * @brief Convert a zero based row and column to a location on the card.
+  * @param [in] row A row in [0, NUM_ROWS).
+  * @param [in] col A column in [0, NUM_COLS).
+  * @return The location of the square.
+  */
+  static constexpr unsigned location(unsigned row, unsigned col) {
+    return NUM_ROWS * col + row;
+  }
+
+  /**
+  * @brief The zero based column of a location on the card.
+  * @param [in] location A location in [0, NUM_SQUARES).
+  * @return The column of the square.
+  */
+  static constexpr unsigned column(unsigned location) {
+    return location / NUM_ROWS;
+  }
+
+  /**
+  * @brief The zero based row of a location on the card.
+  * @param [in] location A location in [0, NUM_SQUARES).
+  * @return The row of the square.
+  */
+  static constexpr unsigned row(unsigned location) {
+    return location % NUM_ROWS;
+  }
+
+  /**< Rows, then columns, then the diagonals, then blackout. >**/
+  static constexpr std::array<unsigned, NUM_MASKS> MASKS =
+    BasicWinPatterns::makeMasks();
+
+  /**< Bit m of LINES_OF[location] is set if MASKS[m] holds the location. >**/
+  static constexpr std::array<unsigned, NUM_SQUARES> LINES_OF =
+    BasicWinPatterns::makeLinesOf();
+
+  /**< The number of squares in each of the MASKS. >**/
+  static constexpr std::array<unsigned, NUM_MASKS> MASK_SIZES =
+    BasicWinPatterns::makeMaskSizes();
+
+  /**< Indexed by BingoTypes::victoryType, entry 0 is unused. >**/
+  static constexpr PatternSet
+    PATTERN_SETS[BingoTypes::NUM_VICTORY_TYPES + 1] = {
+    {0, 0, "Not defined"},
+    {0, NUM_ROWS, Cols == 5 ? "Daub five squares in a horizontal line."
+                            : "Daub every square in a horizontal line."},
+    {NUM_ROWS, NUM_COLS, Rows == 5 ? "Daub five squares in a vertical line."
+                                   : "Daub every square in a vertical line."},
+    {0, NUM_ROWS + NUM_COLS + NUM_DIAGONALS, Rows == 5 && Cols == 5
+     ? "Daub five squares in a horizontal, vertical or diagonal line."
+     : "Daub every square in a horizontal, vertical or diagonal line."},
+    {NUM_MASKS - 1, 1, "Daub all squares on the card."}
+  };
+
+  /**
+  * @brief Determines if victory is one of the victory types in the table.
+  * @param [in] victory A victory type.
+  * @return true, if the table has masks for victory, false otherwise.
+  */
+  static constexpr bool isValid(BingoTypes::victoryType victory) {
+    return victory >= 1 && victory <= BingoTypes::NUM_VICTORY_TYPES;
+  }
+
+  /**
+  * @brief Access the masks that win for a victory type.
+  * @param [in] victory A victory type.
+  * @return The PatternSet for victory, an empty set if it is not valid.
+  */
+  static constexpr const PatternSet&
+    patterns(BingoTypes::victoryType victory) {
+    return PATTERN_SETS[isValid(victory) ? victory : 0];
+  }
+
+  /**
+  * @brief Determines if any mask of the victory type is covered by daubMask.
+  * @param [in] victory A victory type.
+  * @param [in] daubMask The correctly daubed squares of a bingo card.
+  * @return true, if a winning mask is fully daubed, false otherwise.
+  */
+  static constexpr bool hasWon(BingoTypes::victoryType victory,
+                               unsigned daubMask) {
+    const PatternSet& set = patterns(victory);
+    for (unsigned i = set.first; i < set.first + set.count; ++i) {
+      if ((daubMask & MASKS[i]) == MASKS[i])
+        return true;
+    }
+    return false;
+  }
+
+ private:
+  /**
+  * @brief Build the MASKS table.
+  * @return The row, column, diagonal and blackout masks.
+  */
+  static constexpr std::array<unsigned, NUM_MASKS> makeMasks() {
+    std::array<unsigned, NUM_MASKS> masks{};
+    for (unsigned i = 0; i < NUM_ROWS; ++i) {
+      for (unsigned k = 0; k < NUM_COLS; ++k) {
+        masks[i] |= 1u << location(i, k);
+        masks[NUM_ROWS + k] |= 1u << location(i, k);
+      }
+    }
+    for (unsigned i = 0; NUM_DIAGONALS != 0 && i < NUM_ROWS; ++i) {
+      masks[NUM_ROWS + NUM_COLS] |= 1u << location(i, i);
+      masks[NUM_ROWS + NUM_COLS + 1] |= 1u << location(i, NUM_COLS - 1 - i);
+    }
+    masks[NUM_MASKS - 1] = ~0u >> (32 - NUM_SQUARES);
+    return masks;
+  }
+
+  /**
+  * @brief Build the LINES_OF table.
+  * @return For each location, the set of MASKS holding it.
+  */
+  static constexpr std::array<unsigned, NUM_SQUARES> makeLinesOf() {
+    std::array<unsigned, NUM_MASKS> masks =
+    BasicWinPatterns::makeMasks();
+    std::array<unsigned, NUM_SQUARES> lines{};
+    for (unsigned m = 0; m < NUM_MASKS; ++m) {
+      for (unsigned i = 0; i < NUM_SQUARES; ++i) {
+        if (masks[m] & (1u << i))
+          lines[i] |= 1u << m;
+      }
+    }
+    return lines;
+  }
+
+  /**
+  * @brief Build the MASK_SIZES table.
+  * @return The number of squares in each of the MASKS.
+  */
+  static constexpr std::array<unsigned, NUM_MASKS> makeMaskSizes() {
+    std::array<unsigned, NUM_MASKS> masks =
+    BasicWinPatterns::makeMasks();
+    std::array<unsigned, NUM_MASKS> sizes{};
+    for (unsigned m = 0; m < NUM_MASKS; ++m) {
+      for (unsigned i = 0; i < NUM_SQUARES; ++i) {
+        if (masks[m] & (1u << i))
+          ++sizes[m];
+      }
+    }
+    return sizes;
+  }
+};
+
+/**< The 5 x 5 card with a free center square every bingo game uses. >**/
+typedef BasicWinPatterns<5, 5, 12> WinPatterns;
+
+static_assert(WinPatterns::MASKS[0] == 0x108421u, "first row");
+static_assert(WinPatterns::MASKS[WinPatterns::NUM_ROWS] == 0x1fu,
+              "first column");
+static_assert(WinPatterns::hasWon(BingoTypes::ANY_LINE, 0x1041041u),
+              "main diagonal");
+static_assert(WinPatterns::LINES_OF[WinPatterns::FREE_LOCATION] == 0x1c84u,
+              "the free square is on its row, column, both diagonals and "
+              "blackout");
+
+#endif // WIN_PATTERNS_H_INCLUDED
@@ -0,0 +1,124 @@
+/**
+* @file BenchActionQueue.cpp
+* @brief Actions per second through the MpscQueue of ActionQueue against a
+*   std::mutex guarded std::deque, for 1 to 64 producer threads and one
+*   consumer draining in batches.
+* @details Both queues hold CAPACITY actions. A producer retries when the
+*   queue is full, the retries are reported as a measure of how often the
+*   consumer fell behind, and the consumer yields when it is empty. Build from
+*   Order_274632442 with:
+*   g++ -std=c++17 -O2 -pthread -I. bench/BenchActionQueue.cpp
+*   -o benchActionQueue
+*/
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "BingoGame.h"
+#include "MpscQueue.h"
+
+namespace {
+
+const unsigned long NUM_ACTIONS = 1 << 22;
+const unsigned BATCH_SIZE = 64;
+const std::size_t CAPACITY = 4096;
+
+typedef BingoGame::playerAction action;
+
+/**
+* @brief The baseline, a deque behind one lock, bounded like the ring.
+*/
+class LockedQueue {
+ public:
+  explicit LockedQueue(std::size_t capacity) : _capacity{capacity} {}
+
+  bool push(action& item) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_items.size() == _capacity) {
+      return false;
+    }
+    _items.push_back(item);
+    return true;
+  }
+
+  std::size_t popBatch(action* items, std::size_t maxItems) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::size_t count = 0;
+    while (count < maxItems && !_items.empty()) {
+      items[count++] = _items.front();
+      _items.pop_front();
+    }
+    return count;
+  }
+
+ private:
+  std::size_t _capacity;
+  std::mutex _mutex;
+  std::deque<action> _items;
+};
+
+template <typename Queue>
+void run(const char* name, Queue& queue, unsigned numProducers) {
+  std::atomic<unsigned long> retries{0};
+  std::atomic<bool> go{false};
+  std::vector<std::thread> producers;
+  unsigned long perProducer = NUM_ACTIONS / numProducers;
+  for (unsigned p = 0; p < numProducers; ++p) {
+    producers.emplace_back([&, p]() {
+      while (!go.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+      }
+      unsigned long failed = 0;
+      for (unsigned long i = 0; i < perProducer; ++i) {
+        action a{p, BingoTypes::DAUB,
+          {static_cast<unsigned>(i % 5 + 1), p % 5 + 1}};
+        while (!queue.push(a)) {
+          ++failed;
+          std::this_thread::yield();
+        }
+      }
+      retries += failed;
+    });
+  }
+
+  action batch[BATCH_SIZE];
+  unsigned long received = 0;
+  unsigned long checksum = 0;
+  auto start = std::chrono::steady_clock::now();
+  go.store(true, std::memory_order_release);
+  while (received < perProducer * numProducers) {
+    std::size_t count = queue.popBatch(batch, BATCH_SIZE);
+    if (count == 0) {
+      std::this_thread::yield();
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+      checksum += batch[i].pos.row;
+    }
+    received += count;
+  }
+  std::chrono::duration<double> elapsed =
+    std::chrono::steady_clock::now() - start;
+  for (std::thread& t : producers) {
+    t.join();
+  }
+  std::cout << name << ' ' << numProducers << " producers: "
+            << received / elapsed.count() / 1e6 << " M actions/s, "
+            << retries << " full retries"
+            << (checksum == 0 ? " (empty)" : "") << '\n';
+}
+
+}  // namespace
+
+int main() {
+  for (unsigned producers = 1; producers <= 64; producers *= 2) {
+    MpscQueue<action> lockFree(CAPACITY);
+    run("MpscQueue", lockFree, producers);
+    LockedQueue locked(CAPACITY);
+    run("mutex+deque", locked, producers);
+  }
+  return 0;
+}
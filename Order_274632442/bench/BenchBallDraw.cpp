@@ -0,0 +1,81 @@
+/**
+* @file BenchBallDraw.cpp
+* @brief Balls pulled per second over a million 75 ball games, for the old
+*   erase from a vector cage, BingoCaller::pullBall and drawSequence.
+* @details Build from Order_274632442 with:
+*   g++ -std=c++17 -O2 -I. bench/BenchBallDraw.cpp BingoCaller.cpp
+*   ClueTable.cpp EmbeddedClues.cpp MakeRandomInt.cpp MappedFile.cpp
+*   -o benchBallDraw
+*/
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "BingoCaller.h"
+#include "MakeRandomInt.h"
+
+namespace {
+
+const unsigned NUM_GAMES = 1000000;
+
+template <typename F>
+double pullsPerSecond(F playGame) {
+  auto start = std::chrono::steady_clock::now();
+  unsigned long pulls = 0;
+  unsigned long checksum = 0;
+  for (unsigned g = 0; g < NUM_GAMES; ++g) {
+    checksum += playGame(pulls);
+  }
+  std::chrono::duration<double> elapsed =
+    std::chrono::steady_clock::now() - start;
+  if (checksum == 0) {
+    std::cout << "(no balls)\n";
+  }
+  return pulls / elapsed.count();
+}
+
+}  // namespace
+
+int main() {
+  MakeRandomInt& randInt = MakeRandomInt::getInstance();
+  std::vector<unsigned> cage;
+  std::vector<unsigned> chosen;
+
+  double erase = pullsPerSecond([&](unsigned long& pulls) {
+    cage.clear();
+    chosen.clear();
+    for (unsigned i = 1; i <= 75; ++i) {
+      cage.push_back(i);
+    }
+    while (!cage.empty()) {
+      auto it = cage.begin() + randInt.getValue(cage.size());
+      chosen.push_back(*it);
+      cage.erase(it);
+      ++pulls;
+    }
+    return chosen.back();
+  });
+  std::cout << "vector erase: " << erase << " pulls/s\n";
+
+  Bingo75Caller caller;
+  double swap = pullsPerSecond([&](unsigned long& pulls) {
+    caller.resetGame();
+    while (caller.pullBall()) {
+      ++pulls;
+    }
+    return caller.getCurrentNumber();
+  });
+  std::cout << "pullBall: " << swap << " pulls/s (" << swap / erase
+            << "x)\n";
+
+  double drawn = pullsPerSecond([&](unsigned long& pulls) {
+    caller.resetGame();
+    caller.drawSequence();
+    pulls += caller.getNumBalls();
+    return caller.getSequence()[caller.getNumBalls() - 1];
+  });
+  std::cout << "drawSequence: " << drawn << " pulls/s (" << drawn / erase
+            << "x)\n";
+
+  return 0;
+}
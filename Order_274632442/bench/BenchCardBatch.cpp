@@ -0,0 +1,94 @@
+/**
+* @file BenchCardBatch.cpp
+* @brief Cards per second for CardBatch kernels against
+*   VictoryCondition::hasWon on a card's grid.
+* @details Build from Order_274632442 with:
+*   g++ -std=c++17 -O2 -I. bench/BenchCardBatch.cpp CardBatch.cpp
+*   VictoryCondition.cpp Square.cpp DaubState.cpp -o benchCardBatch
+*/
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "BingoCard.h"
+#include "CardBatch.h"
+#include "Square.h"
+#include "VictoryCondition.h"
+#include "WinPatterns.h"
+
+namespace {
+
+const unsigned NUM_CARDS = 200000;
+const unsigned REPEATS = 20;
+
+template <typename F>
+double cardsPerSecond(F check) {
+  auto start = std::chrono::steady_clock::now();
+  unsigned long winners = 0;
+  for (unsigned r = 0; r < REPEATS; ++r) {
+    winners += check();
+  }
+  std::chrono::duration<double> elapsed =
+    std::chrono::steady_clock::now() - start;
+  if (winners == 0) {
+    std::cout << "(no winners)\n";
+  }
+  return NUM_CARDS * double(REPEATS) / elapsed.count();
+}
+
+unsigned countBits(const std::vector<std::uint64_t>& bitmap) {
+  unsigned count = 0;
+  for (std::uint64_t word : bitmap) {
+    count += __builtin_popcountll(word);
+  }
+  return count;
+}
+
+}  // namespace
+
+int main() {
+  std::mt19937 generator(2024);
+  std::bernoulli_distribution daubed(0.6);
+  AnyLine victory;
+
+  CardBatch batch(victory.getVictoryType());
+  std::vector<BingoCard::gridType> grids(NUM_CARDS);
+  for (unsigned c = 0; c < NUM_CARDS; ++c) {
+    unsigned mask = 1u << WinPatterns::FREE_LOCATION;
+    for (unsigned i = 0; i < WinPatterns::NUM_SQUARES; ++i) {
+      if (i == WinPatterns::FREE_LOCATION) {
+        grids[c][i] = FreeSquare();
+        continue;
+      }
+      grids[c][i] = IntSquare(i + 1);
+      if (daubed(generator)) {
+        grids[c][i].daubSquare(i + 1);
+        mask |= 1u << i;
+      }
+    }
+    batch.addCard(mask);
+  }
+
+  double grid = cardsPerSecond([&] {
+    unsigned count = 0;
+    for (auto& cardGrid : grids) {
+      count += victory.hasWon(cardGrid);
+    }
+    return count;
+  });
+  std::cout << "VictoryCondition::hasWon(grid): " << grid << " cards/s\n";
+
+  const char* names[] = {"scalar", "sse2", "avx2"};
+  for (int k = CardBatch::SCALAR; k <= CardBatch::bestKernel(); ++k) {
+    CardBatch::kernelType kernel = static_cast<CardBatch::kernelType>(k);
+    double rate = cardsPerSecond([&] {
+      return countBits(batch.findWinners(kernel));
+    });
+    std::cout << "CardBatch " << names[k] << ": " << rate << " cards/s ("
+              << rate / grid << "x)\n";
+  }
+
+  return 0;
+}
@@ -0,0 +1,123 @@
+/**
+* @file BenchJournal.cpp
+* @brief The cost of recording a game in a GameJournal, and events per
+*   second when the journal is replayed.
+* @details 100k players join, then every round pulls a ball and every
+*   player daubs one square with a packed batch, for 20 rounds. The game
+*   is played without and with a journal, which is committed once a round.
+*   Most daubs are of the wrong number, which costs the card a pass over
+*   its squares, in play and in the replay alike. The replay rebuilds the
+*   game from the journal while it is in the page cache, as after a
+*   process restart, and the check is the part of it that finds the whole
+*   events. Build from Order_274632442 with:
+*   g++ -std=c++17 -O2 -I. bench/BenchJournal.cpp BingoGame.cpp
+*   BingoCaller.cpp BingoCard.cpp BingoCardFactory.cpp CardArena.cpp
+*   CardBatch.cpp ClueTable.cpp DaubState.cpp EmbeddedClues.cpp
+*   FlatIdMap.cpp GameJournal.cpp MakeRandomInt.cpp MappedFile.cpp
+*   NumberIndex.cpp ScreenDisplay.cpp Square.cpp UserInput.cpp
+*   VictoryCondition.cpp -o benchJournal
+*   Run as benchJournal [file].
+*/
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "BingoCaller.h"
+#include "BingoCardFactory.h"
+#include "BingoGame.h"
+#include "GameJournal.h"
+#include "MappedFile.h"
+#include "VictoryCondition.h"
+
+namespace {
+
+const unsigned NUM_PLAYERS = 100000;
+const unsigned NUM_ROUNDS = 20;
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+  std::chrono::duration<double> elapsed =
+    std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+/**
+* @brief Play the game, recording it in journal unless it is a nullptr.
+* @return The seconds the rounds took, the joins are not timed.
+*/
+double play(GameJournal* journal) {
+  AnyLine victory;
+  BingoCardFactory factory;
+  Bingo75Caller caller(BingoTypes::ANY_LINE);
+  caller.setGameStream(1, 2);
+  BingoGame game;
+  game.setCaller(&caller);
+  game.setAutoDaub(false);
+  game.setJournal(journal);
+  for (unsigned i = 0; i < NUM_PLAYERS; ++i) {
+    game.joinGame("player" + std::to_string(i),
+                  factory.makeBingoCard(BingoTypes::BINGO75, &victory,
+                                        game.getCardArena()));
+  }
+
+  std::ostringstream out;
+  std::vector<BingoGame::packedAction> daubs;
+  std::vector<BingoGame::actionResult> results;
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned round = 0; round < NUM_ROUNDS; ++round) {
+    game.completeNextCall(out);
+    daubs.clear();
+    for (unsigned i = 0; i < NUM_PLAYERS; ++i) {
+      daubs.push_back(BingoGame::pack({i, BingoTypes::DAUB,
+                                       {round % 5 + 1, (i + round / 5) % 5
+                                        + 1}}));
+    }
+    game.takeActions(daubs.data(), daubs.size(), results);
+  }
+  double seconds = secondsSince(start);
+  game.setJournal(nullptr);
+  return seconds;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::string fileName = argc > 1 ? argv[1] : "benchJournal.bin";
+  std::remove(fileName.c_str());
+  double moves = double{NUM_PLAYERS} * NUM_ROUNDS;
+
+  double plain = play(nullptr);
+  std::cout << "no journal: " << moves / plain / 1e6 << " M daubs/s\n";
+
+  std::size_t numEvents;
+  {
+    GameJournal journal(fileName, BingoTypes::BINGO75);
+    double recorded = play(&journal);
+    numEvents = journal.getNumEvents();
+    std::cout << "journal: " << moves / recorded / 1e6 << " M daubs/s, "
+              << numEvents << " events\n";
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  {
+    MappedFile file(fileName, "journal");
+    std::size_t checked = GameJournal::readEvents(file.getText(),
+                                                  BingoTypes::BINGO75,
+                                                  fileName).size();
+    std::cout << "check: " << checked / secondsSince(start) / 1e6
+              << " M events/s\n";
+  }
+
+  Bingo75Caller caller(BingoTypes::ANY_LINE);
+  BingoGame game;
+  game.setCaller(&caller);
+  start = std::chrono::steady_clock::now();
+  std::size_t replayed = game.replayJournal(fileName);
+  double seconds = secondsSince(start);
+  std::cout << "replay: " << replayed / seconds / 1e6 << " M events/s, "
+            << game.getNumPlayers() << " players\n";
+  std::remove(fileName.c_str());
+  return replayed == numEvents ? 0 : 1;
+}
@@ -0,0 +1,115 @@
+/**
+* @file BenchPackedActions.cpp
+* @brief Moves per second through the text moves and through takeActions.
+* @details 1000 players each daub every square of their card, then claim
+*   bingo as many times. The text move reads the square from an istream
+*   and reports to an ostream, the parsed move only reports, and the
+*   packed batch does neither. The output is thrown away. Most daubs are
+*   of the wrong number, which costs the card a pass over its squares, so
+*   the claims show the cost of the move itself. Build from
+*   Order_274632442 with:
+*   g++ -std=c++17 -O2 -I. bench/BenchPackedActions.cpp BingoGame.cpp
+*   BingoCaller.cpp BingoCard.cpp BingoCardFactory.cpp CardArena.cpp
+*   CardBatch.cpp ClueTable.cpp DaubState.cpp EmbeddedClues.cpp
+*   FlatIdMap.cpp GameJournal.cpp MakeRandomInt.cpp MappedFile.cpp
+*   NumberIndex.cpp ScreenDisplay.cpp Square.cpp UserInput.cpp
+*   VictoryCondition.cpp -o benchPackedActions
+*/
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "BingoCaller.h"
+#include "BingoCardFactory.h"
+#include "BingoGame.h"
+#include "NullStream.h"
+#include "VictoryCondition.h"
+
+namespace {
+
+const unsigned NUM_PLAYERS = 1000;
+const unsigned NUM_ROUNDS = 20;
+
+/**
+* @brief A game of NUM_PLAYERS players with one ball pulled.
+*/
+struct benchGame {
+  Bingo75Caller caller{BingoTypes::ANY_LINE};
+  AnyLine victory;
+  BingoGame game;
+
+  benchGame() {
+    BingoCardFactory factory;
+    game.setCaller(&caller);
+    game.setAutoDaub(false);
+    for (unsigned i = 0; i < NUM_PLAYERS; ++i) {
+      game.joinGame("p" + std::to_string(i),
+                    factory.makeBingoCard(BingoTypes::BINGO75, &victory,
+                                          game.getCardArena()));
+    }
+    nullBuf buf;
+    std::ostream out(&buf);
+    game.completeNextCall(out);
+  }
+};
+
+template <typename Moves>
+void run(const char* name, BingoTypes::moveType move, Moves moves) {
+  benchGame g;
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned round = 0; round < NUM_ROUNDS; ++round) {
+    moves(g.game, move);
+  }
+  std::chrono::duration<double> elapsed =
+    std::chrono::steady_clock::now() - start;
+  std::cout << (move == BingoTypes::DAUB ? "daub " : "bingo ") << name
+            << ": " << NUM_ROUNDS * NUM_PLAYERS * 25 / elapsed.count() / 1e6
+            << " M moves/s\n";
+}
+
+}  // namespace
+
+int main() {
+  nullBuf buf;
+  std::ostream out(&buf);
+
+  for (BingoTypes::moveType move : {BingoTypes::DAUB, BingoTypes::BINGO}) {
+    run("text move", move, [&](BingoGame& game, BingoTypes::moveType m) {
+      for (unsigned p = 0; p < NUM_PLAYERS; ++p) {
+        for (unsigned row = 1; row <= 5; ++row) {
+          for (unsigned col = 1; col <= 5; ++col) {
+            std::istringstream in(std::to_string(row) + " "
+                                  + std::to_string(col));
+            game.takeAction(out, in, p, m);
+          }
+        }
+      }
+    });
+
+    run("parsed move", move, [&](BingoGame& game, BingoTypes::moveType m) {
+      for (unsigned p = 0; p < NUM_PLAYERS; ++p) {
+        for (unsigned row = 1; row <= 5; ++row) {
+          for (unsigned col = 1; col <= 5; ++col) {
+            game.takeAction(out, {p, m, {row, col}});
+          }
+        }
+      }
+    });
+
+    std::vector<BingoGame::packedAction> actions;
+    for (unsigned p = 0; p < NUM_PLAYERS; ++p) {
+      for (unsigned row = 1; row <= 5; ++row) {
+        for (unsigned col = 1; col <= 5; ++col) {
+          actions.push_back(BingoGame::pack({p, move, {row, col}}));
+        }
+      }
+    }
+    std::vector<BingoGame::actionResult> results;
+    run("packed batch", move, [&](BingoGame& game, BingoTypes::moveType) {
+      game.takeActions(actions.data(), actions.size(), results);
+    });
+  }
+  return 0;
+}
@@ -0,0 +1,95 @@
+/**
+* @file BenchPlayerSession.cpp
+* @brief Answers per second when one thread multiplexes the PlayerSessions
+*   of up to 10k players of one game.
+* @details Every player daubs each square of the card in turn. The input
+*   arrives in pieces of 1 to 8 characters, a piece for each player in
+*   turn, so most pieces end in the middle of an answer and the session is
+*   suspended until the next one. The output is thrown away. Build from
+*   Order_274632442 with:
+*   g++ -std=c++17 -O2 -I. bench/BenchPlayerSession.cpp PlayerSession.cpp
+*   BingoGame.cpp BingoCaller.cpp BingoCard.cpp BingoCardFactory.cpp
+*   CardArena.cpp CardBatch.cpp ClueTable.cpp DaubState.cpp
+*   EmbeddedClues.cpp FlatIdMap.cpp GameJournal.cpp MakeRandomInt.cpp
+*   MappedFile.cpp NumberIndex.cpp ScreenDisplay.cpp Square.cpp
+*   UserInput.cpp VictoryCondition.cpp -o benchPlayerSession
+*/
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "BingoCaller.h"
+#include "BingoCardFactory.h"
+#include "BingoGame.h"
+#include "NullStream.h"
+#include "PlayerSession.h"
+#include "VictoryCondition.h"
+
+namespace {
+
+void run(unsigned numPlayers) {
+  Bingo75Caller caller(BingoTypes::ANY_LINE);
+  AnyLine victory;
+  BingoCardFactory factory;
+  BingoGame game;
+  game.setCaller(&caller);
+  game.setAutoDaub(false);
+
+  std::vector<PlayerSession> sessions;
+  sessions.reserve(numPlayers);
+  for (unsigned i = 0; i < numPlayers; ++i) {
+    std::string id = "p" + std::to_string(i);
+    game.joinGame(id, factory.makeBingoCard(BingoTypes::BINGO75, &victory,
+                                            game.getCardArena()));
+    sessions.emplace_back(&game, game.getPlayerHandle(id));
+  }
+
+  std::string script;
+  unsigned numAnswers = 0;
+  for (unsigned row = 1; row <= 5; ++row) {
+    for (unsigned col = 1; col <= 5; ++col) {
+      script += "1\n" + std::to_string(row) + " " + std::to_string(col) + "\n";
+      numAnswers += 2;
+    }
+  }
+
+  nullBuf buf;
+  std::ostream out(&buf);
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<std::size_t> pieceSize(1, 8);
+  std::vector<std::size_t> sent(numPlayers, 0);
+  unsigned long numPieces = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned done = 0; done < numPlayers; ) {
+    done = 0;
+    for (unsigned i = 0; i < numPlayers; ++i) {
+      if (sent[i] == script.size()) {
+        ++done;
+        continue;
+      }
+      std::size_t size = std::min(pieceSize(rng), script.size() - sent[i]);
+      sessions[i].resume(out, std::string_view(script).substr(sent[i], size));
+      sent[i] += size;
+      ++numPieces;
+    }
+  }
+  std::chrono::duration<double> elapsed =
+    std::chrono::steady_clock::now() - start;
+  std::cout << numPlayers << " players: "
+            << numAnswers * numPlayers / elapsed.count() / 1e6
+            << " M answers/s, "
+            << numPieces / elapsed.count() / 1e6 << " M pieces/s\n";
+}
+
+}  // namespace
+
+int main() {
+  for (unsigned players = 10; players <= 10000; players *= 10) {
+    run(players);
+  }
+  return 0;
+}
@@ -0,0 +1,89 @@
+/**
+* @file BenchRoomManager.cpp
+* @brief Turns per second per core and turn latency of a RoomManager as the
+*   number of rooms grows to 100k.
+* @details Every round steps every room once. A turn's latency runs from
+*   stepRoom to the shard finishing the turn, so it includes the time the
+*   message waited behind the other rooms of its shard. Build from
+*   Order_274632442 with:
+*   g++ -std=c++17 -O2 -pthread -I. bench/BenchRoomManager.cpp
+*   RoomManager.cpp BingoGame.cpp BingoCaller.cpp BingoCard.cpp
+*   BingoCardFactory.cpp CardArena.cpp CardBatch.cpp ClueTable.cpp
+*   DaubState.cpp EmbeddedClues.cpp FlatIdMap.cpp GameJournal.cpp
+*   MakeRandomInt.cpp MappedFile.cpp NumberIndex.cpp ScreenDisplay.cpp
+*   Square.cpp UserInput.cpp VictoryCondition.cpp -o benchRoomManager
+*   Run as benchRoomManager [maxRooms [numShards]].
+*/
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "RoomManager.h"
+
+namespace {
+
+const unsigned NUM_PLAYERS = 4;
+const unsigned NUM_ROUNDS = 20;
+
+void waitFor(RoomManager& manager, unsigned long count,
+             std::vector<RoomManager::roomReply>& replies) {
+  replies.clear();
+  while (replies.size() < count) {
+    manager.poll(replies);
+  }
+}
+
+void run(unsigned long numRooms, unsigned numShards) {
+  RoomManager manager(numShards, 1 << 16);
+  std::vector<RoomManager::roomReply> replies;
+  for (unsigned long room = 0; room < numRooms; ++room) {
+    manager.createRoom(BingoTypes::BINGO75, BingoTypes::ANY_LINE);
+    for (unsigned p = 0; p < NUM_PLAYERS; ++p) {
+      manager.joinRoom(room, "player" + std::to_string(p));
+    }
+  }
+  waitFor(manager, numRooms * (NUM_PLAYERS + 1), replies);
+
+  std::vector<double> latency;
+  latency.reserve(numRooms * NUM_ROUNDS);
+  unsigned long games = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned round = 0; round < NUM_ROUNDS; ++round) {
+    for (unsigned long room = 0; room < numRooms; ++room) {
+      manager.stepRoom(room);
+    }
+    waitFor(manager, numRooms, replies);
+    for (const RoomManager::roomReply& reply : replies) {
+      std::chrono::duration<double, std::micro> turn = reply.done - reply.sent;
+      latency.push_back(turn.count());
+      games += reply.gameOver;
+    }
+  }
+  std::chrono::duration<double> elapsed =
+    std::chrono::steady_clock::now() - start;
+
+  std::sort(latency.begin(), latency.end());
+  double turns = numRooms * NUM_ROUNDS / elapsed.count();
+  unsigned shards = manager.getNumShards();
+  std::cout << numRooms << " rooms, " << shards << " shards: "
+            << numRooms / shards << " rooms/core, "
+            << turns / shards << " turns/s/core, p50 "
+            << latency[latency.size() / 2] << " us, p99 "
+            << latency[latency.size() * 99 / 100] << " us, "
+            << games << " games won\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  unsigned long maxRooms = argc > 1 ? std::strtoul(argv[1], nullptr, 10)
+                                    : 100000;
+  unsigned numShards = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 0;
+  for (unsigned long rooms = 100; rooms <= maxRooms; rooms *= 10) {
+    run(rooms, numShards);
+  }
+  return 0;
+}
@@ -0,0 +1,92 @@
+/**
+* @file BenchSnapshot.cpp
+* @brief Time to save and to restore a snapshot of one room as the number
+*   of cards grows to 1M.
+* @details The room has played 20 rounds, with a daub by one player in
+*   five each round, and no winner is declared. The save time
+*   includes the fsync. The restore runs on a file still in the page cache,
+*   as after a process restart. Build from Order_274632442 with:
+*   g++ -std=c++17 -O2 -I. bench/BenchSnapshot.cpp BingoGame.cpp
+*   BingoCaller.cpp BingoCard.cpp BingoCardFactory.cpp CardArena.cpp
+*   CardBatch.cpp ClueTable.cpp DaubState.cpp EmbeddedClues.cpp
+*   FlatIdMap.cpp GameJournal.cpp MakeRandomInt.cpp MappedFile.cpp
+*   NumberIndex.cpp ScreenDisplay.cpp Square.cpp UserInput.cpp
+*   VictoryCondition.cpp -o benchSnapshot
+*   Run as benchSnapshot [file [maxCards]].
+*/
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "BingoCaller.h"
+#include "BingoCardFactory.h"
+#include "BingoGame.h"
+#include "VictoryCondition.h"
+
+namespace {
+
+const unsigned NUM_ROUNDS = 20;
+
+double millisSince(std::chrono::steady_clock::time_point start) {
+  std::chrono::duration<double, std::milli> elapsed =
+    std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+void run(const std::string& fileName, unsigned numCards) {
+  AnyLine victory;
+  BingoCardFactory factory;
+  Bingo75Caller caller(BingoTypes::ANY_LINE);
+  caller.setGameStream(1, numCards);
+  BingoGame game;
+  game.setCaller(&caller);
+  game.setAutoDaub(false);
+  for (unsigned i = 0; i < numCards; ++i) {
+    game.joinGame("player" + std::to_string(i),
+                  factory.makeBingoCard(BingoTypes::BINGO75, &victory,
+                                        game.getCardArena()));
+  }
+  std::ostringstream out;
+  std::vector<BingoGame::packedAction> daubs;
+  std::vector<BingoGame::actionResult> results;
+  for (unsigned round = 0; round < NUM_ROUNDS; ++round) {
+    game.completeNextCall(out);
+    daubs.clear();
+    for (unsigned i = round; i < numCards; i += 5) {
+      daubs.push_back(BingoGame::pack({i, BingoTypes::DAUB,
+                                       {round % 5 + 1, i % 5 + 1}}));
+    }
+    game.takeActions(daubs.data(), daubs.size(), results);
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  game.saveSnapshot(fileName);
+  double saveTime = millisSince(start);
+
+  Bingo75Caller restoredCaller(BingoTypes::ANY_LINE);
+  BingoGame restored;
+  restored.setCaller(&restoredCaller);
+  start = std::chrono::steady_clock::now();
+  restored.restoreSnapshot(fileName);
+  double restoreTime = millisSince(start);
+
+  std::cout << numCards << " cards: save " << saveTime << " ms, restore "
+            << restoreTime << " ms, " << restored.getNumPlayers()
+            << " players\n";
+  std::remove(fileName.c_str());
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::string fileName = argc > 1 ? argv[1] : "benchSnapshot.bin";
+  unsigned maxCards = argc > 2 ? std::atoi(argv[2]) : 1000000;
+  for (unsigned cards = 1000; cards <= maxCards; cards *= 10) {
+    run(fileName, cards);
+  }
+  return 0;
+}
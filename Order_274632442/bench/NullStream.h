@@ -0,0 +1,23 @@
+
+#ifndef NULL_STREAM_H_INCLUDED
+#define NULL_STREAM_H_INCLUDED
+
+#include <streambuf>
+
+/**
+* @class nullBuf NullStream.h "NullStream.h"
+* @brief Discards everything written to it, for benches that time moves
+*   without their output.
+*/
+class nullBuf : public std::streambuf {
+ protected:
+  int overflow(int ch) override {
+    return ch;
+  }
+
+  std::streamsize xsputn(const char*, std::streamsize n) override {
+    return n;
+  }
+};
+
+#endif // NULL_STREAM_H_INCLUDED
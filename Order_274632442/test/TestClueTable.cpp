@@ -0,0 +1,108 @@
+/**
+* @file TestClueTable.cpp
+* @brief Tests of reading clue files into a ClueTable.
+* @details Run from Order_274632442, the clue files are read from src/csv.
+*   Build from Order_274632442 with:
+*   g++ -std=c++17 -I. test/TestClueTable.cpp ClueTable.cpp MappedFile.cpp
+*   EmbeddedClues.cpp -lgtest -lgtest_main -pthread -o testClueTable
+*/
+#include <string>
+
+#include "gtest/gtest.h"
+#include "ClueTable.h"
+#include "Exceptions.h"
+
+namespace {
+
+/**
+* @brief The message of the bad_input thrown for a clues file, empty if
+*   the file is read.
+*/
+std::string errorOf(const std::string& cluesFile) {
+  try {
+    ClueTable::readFile(cluesFile, 50);
+  } catch (const bad_input& e) {
+    return e.what();
+  }
+  return "";
+}
+
+std::string parseError(const std::string& text) {
+  try {
+    ClueTable::parse(text, "text", 3);
+  } catch (const bad_input& e) {
+    return e.what();
+  }
+  return "";
+}
+
+}  // namespace
+
+TEST(TestClueTable, readFileTest) {
+  ClueTable table = ClueTable::readFile("src/csv/bingo50calls.csv", 50);
+  EXPECT_EQ(table.getNumValues(), 50u);
+  EXPECT_GE(table.getNumClues(), 1u);
+  EXPECT_FALSE(table.getClue(50, 0).empty());
+}
+
+TEST(TestClueTable, missingFileTest) {
+  EXPECT_THROW(ClueTable::readFile("src/csv/noSuchFile.csv", 50),
+               bad_input);
+}
+
+TEST(TestClueTable, malformedFileMessagesTest) {
+  const std::string dir = "src/csv/";
+  EXPECT_EQ(errorOf(dir + "bingoCalls_badNumBalls.csv"),
+            dir + "bingoCalls_badNumBalls.csv:1:1: "
+            "expected the number of values");
+  EXPECT_EQ(errorOf(dir + "bingoCalls_startsWithAChar.csv"),
+            dir + "bingoCalls_startsWithAChar.csv:1:1: "
+            "expected the number of values");
+  EXPECT_EQ(errorOf(dir + "bingoCalls_wrongNumBalls.csv"),
+            dir + "bingoCalls_wrongNumBalls.csv:1:1: "
+            "the number of values must be 50");
+  EXPECT_EQ(errorOf(dir + "bingoCalls_badNumClues.csv"),
+            dir + "bingoCalls_badNumClues.csv:1:4: "
+            "expected the number of clues");
+  EXPECT_EQ(errorOf(dir + "bingoCalls_wrongNumClues.csv"),
+            dir + "bingoCalls_wrongNumClues.csv:1:4: "
+            "the number of clues must be between 1 and 10");
+  EXPECT_EQ(errorOf(dir + "bingoCalls_noClueLines.csv"),
+            dir + "bingoCalls_noClueLines.csv:2:1: "
+            "expected the line of clues for value 1");
+  EXPECT_EQ(errorOf(dir + "bingoCalls_badFirstClue.csv"),
+            dir + "bingoCalls_badFirstClue.csv:2:1: "
+            "expected a value at the start of the line");
+  EXPECT_EQ(errorOf(dir + "bingoCalls_wrongFirstClueLine.csv"),
+            dir + "bingoCalls_wrongFirstClueLine.csv:2:1: "
+            "expected the line of clues for value 1");
+  EXPECT_EQ(errorOf(dir + "bingoCalls_missingClue.csv"),
+            dir + "bingoCalls_missingClue.csv:2:3: "
+            "expected clue 1 of value 1");
+  EXPECT_EQ(errorOf(dir + "bingoCalls_tooFewClueLines.csv"),
+            dir + "bingoCalls_tooFewClueLines.csv:5:1: "
+            "expected the line of clues for value 4");
+  EXPECT_EQ(errorOf(dir + "bingoCalls_wrongOrderLines.csv"),
+            dir + "bingoCalls_wrongOrderLines.csv:6:1: "
+            "expected the line of clues for value 5");
+  EXPECT_EQ(errorOf(dir + "bingoCalls_missingNumber.csv"),
+            dir + "bingoCalls_missingNumber.csv:19:1: "
+            "expected the line of clues for value 18");
+  EXPECT_EQ(errorOf(dir + "bingoCalls_badOtherClue.csv"),
+            dir + "bingoCalls_badOtherClue.csv:10:1: "
+            "expected a value at the start of the line");
+}
+
+TEST(TestClueTable, parseTest) {
+  ClueTable table = ClueTable::parse("3,2,\r\n1,a,b,\r\n2,c,d\n3,e,f",
+                                     "text", 3);
+  EXPECT_EQ(table.getNumValues(), 3u);
+  EXPECT_EQ(table.getNumClues(), 2u);
+  EXPECT_EQ(table.getClue(1, 1), "b");
+  EXPECT_EQ(table.getClue(3, 0), "e");
+
+  EXPECT_EQ(parseError("3,2\n1,a,b\n2,c\n3,e,f\n"),
+            "text:3:4: expected clue 2 of value 2");
+  EXPECT_EQ(parseError("3,2\n1,a,b\n2,c,d\n"),
+            "text:4:1: expected the line of clues for value 3");
+}
@@ -0,0 +1,278 @@
+/**
+* @file TestGameJournal.cpp
+* @brief Tests of recording a game in a GameJournal and replaying it.
+* @details Build from Order_274632442 with:
+*   g++ -std=c++17 -I. test/TestGameJournal.cpp BingoGame.cpp
+*   BingoCaller.cpp BingoCard.cpp BingoCardFactory.cpp CardArena.cpp
+*   CardBatch.cpp ClueTable.cpp DaubState.cpp EmbeddedClues.cpp
+*   FlatIdMap.cpp GameJournal.cpp MakeRandomInt.cpp MappedFile.cpp
+*   NumberIndex.cpp ScreenDisplay.cpp Square.cpp UserInput.cpp
+*   VictoryCondition.cpp -lgtest -lgtest_main -pthread -o testGameJournal
+*/
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "BingoCaller.h"
+#include "BingoCard.h"
+#include "BingoCardFactory.h"
+#include "BingoGame.h"
+#include "GameJournal.h"
+#include "VictoryCondition.h"
+
+namespace {
+
+const char* FILE_NAME = "testGameJournal.log";
+
+/**< Long enough for two ID_PART events after its join. >**/
+const std::string LONG_ID = "player-with-an-id-longer-than-one-join-event"
+  "-and-one-id-part-can-hold";
+
+std::string readFile(const char* fileName) {
+  std::ifstream in(fileName, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(in),
+                     std::istreambuf_iterator<char>());
+}
+
+void writeFile(const char* fileName, const std::string& data) {
+  std::ofstream out(fileName, std::ios::binary | std::ios::trunc);
+  out.write(data.data(), data.size());
+}
+
+std::string showCard(BingoGame& game, BingoGame::playerHandle player) {
+  std::ostringstream out;
+  game.takeAction(out, {player, BingoTypes::SHOW_CARD, {0, 0}});
+  return out.str();
+}
+
+/**
+* @brief Daub every square of the current ball on the player's card.
+*/
+void daubCurrent(BingoGame& game, BingoCaller& caller, BingoCard* card,
+                 BingoGame::playerHandle player) {
+  std::ostringstream out;
+  for (unsigned row = 1; row <= 5; ++row) {
+    for (unsigned col = 1; col <= 5; ++col) {
+      if (card->getSquare({row, col})->getValue()
+          == caller.getCurrentNumber()) {
+        game.takeAction(out, {player, BingoTypes::DAUB, {row, col}});
+      }
+    }
+  }
+}
+
+/**
+* @brief A recorded game: p0, the long id and p2 join, p0 leaves, then
+*   balls are called and the players daub them. One more ball is called
+*   last, so the last event is a ball.
+*/
+struct recordedGame {
+  AnyLine victory;
+  Bingo75Caller caller{BingoTypes::ANY_LINE};
+  BingoGame game;
+  std::vector<BingoCard*> cards;
+  std::vector<unsigned> balls;
+  std::size_t numEvents = 0;
+
+  explicit recordedGame(unsigned numCalls) {
+    std::remove(FILE_NAME);
+    GameJournal journal(FILE_NAME, BingoTypes::BINGO75, 4);
+    caller.setGameStream(3, 1);
+    game.setCaller(&caller);
+    game.setAutoDaub(false);
+    game.setJournal(&journal);
+    BingoCardFactory factory;
+    for (const std::string& id : {std::string("p0"), LONG_ID,
+                                  std::string("p2")}) {
+      cards.push_back(factory.makeBingoCard(BingoTypes::BINGO75, &victory,
+                                            game.getCardArena()));
+      game.joinGame(id, cards.back());
+    }
+    game.leaveGame("p0");
+    std::ostringstream out;
+    for (unsigned call = 0; call < numCalls; ++call) {
+      game.completeNextCall(out);
+      daubCurrent(game, caller, cards[1], 1);
+      daubCurrent(game, caller, cards[2], 2);
+      balls.push_back(caller.getCurrentNumber());
+    }
+    game.completeNextCall(out);
+    balls.push_back(caller.getCurrentNumber());
+    game.setJournal(nullptr);
+    journal.commit();
+    numEvents = journal.getNumEvents();
+  }
+};
+
+}  // namespace
+
+TEST(TestGameJournal, replayMatchesLiveGameTest) {
+  recordedGame recorded(6);
+  Bingo75Caller caller(BingoTypes::HORIZONTAL_LINE);
+  BingoGame game;
+  game.setCaller(&caller);
+  EXPECT_EQ(game.replayJournal(FILE_NAME), recorded.numEvents);
+  std::remove(FILE_NAME);
+
+  EXPECT_EQ(game.getNumPlayers(), 2u);
+  EXPECT_EQ(game.getPlayerHandle(LONG_ID), 1u);
+  EXPECT_EQ(game.getPlayerId(2), "p2");
+  EXPECT_TRUE(game.getPlayerHandle("p0") == BingoGame::NO_PLAYER);
+  EXPECT_EQ(game.getVictoryType(), BingoTypes::ANY_LINE);
+  EXPECT_FALSE(game.getAutoDaub());
+  EXPECT_EQ(caller.getNumBallsPulled(), 7u);
+  EXPECT_EQ(caller.getCurrentNumber(), recorded.caller.getCurrentNumber());
+  EXPECT_EQ(showCard(game, 1), showCard(recorded.game, 1));
+  EXPECT_EQ(showCard(game, 2), showCard(recorded.game, 2));
+}
+
+TEST(TestGameJournal, joinWithIdPartsInOneBatchTest) {
+  std::remove(FILE_NAME);
+  AnyLine victory;
+  BingoCardFactory factory;
+  Bingo75Caller caller(BingoTypes::ANY_LINE);
+  BingoGame game;
+  game.setCaller(&caller);
+  {
+    GameJournal journal(FILE_NAME, BingoTypes::BINGO75, 2);
+    game.setJournal(&journal);
+    for (const std::string& id : {std::string("p0"), LONG_ID}) {
+      game.joinGame(id, factory.makeBingoCard(BingoTypes::BINGO75, &victory,
+                                              game.getCardArena()));
+      // A batch is written whole, so the file never ends inside a join.
+      std::string data = readFile(FILE_NAME);
+      ASSERT_EQ(data.size() % sizeof(GameJournal::event), 0u);
+      const GameJournal::event* events =
+        reinterpret_cast<const GameJournal::event*>(data.data());
+      std::size_t numEvents = data.size() / sizeof(GameJournal::event);
+      for (std::size_t i = 0; i < numEvents; ++i) {
+        if (events[i].type == GameJournal::PLAYER_JOINED) {
+          EXPECT_LE(i + GameJournal::numIdParts(events[i].size),
+                    numEvents - 1);
+        }
+      }
+    }
+    game.joinGame("p2", factory.makeBingoCard(BingoTypes::BINGO75, &victory,
+                                              game.getCardArena()));
+    game.setJournal(nullptr);
+    EXPECT_EQ(GameJournal::numIdParts(LONG_ID.size()), 2u);
+    EXPECT_EQ(journal.getNumEvents(), 1u + 1 + 3 + 1);
+  }
+
+  Bingo75Caller replayCaller(BingoTypes::ANY_LINE);
+  BingoGame replayed;
+  replayed.setCaller(&replayCaller);
+  EXPECT_EQ(replayed.replayJournal(FILE_NAME), 6u);
+  std::remove(FILE_NAME);
+  EXPECT_EQ(replayed.getPlayerId(1), LONG_ID);
+  EXPECT_EQ(replayed.getPlayerHandle("p2"), 2u);
+}
+
+TEST(TestGameJournal, damagedLastEventTest) {
+  recordedGame recorded(3);
+  // Corrupt the number of the last ball.
+  std::string data = readFile(FILE_NAME);
+  data[data.size() - sizeof(GameJournal::event) + 13] ^= 1;
+  writeFile(FILE_NAME, data);
+
+  Bingo75Caller caller(BingoTypes::ANY_LINE);
+  BingoGame game;
+  game.setCaller(&caller);
+  EXPECT_EQ(game.replayJournal(FILE_NAME), recorded.numEvents - 1);
+  EXPECT_EQ(caller.getNumBallsPulled(), 3u);
+  EXPECT_EQ(caller.getCurrentNumber(), recorded.balls[2]);
+  EXPECT_EQ(game.getNumPlayers(), 2u);
+  EXPECT_EQ(showCard(game, 1), showCard(recorded.game, 1));
+  EXPECT_EQ(showCard(game, 2), showCard(recorded.game, 2));
+
+  // Reopening the journal cuts the damaged event off.
+  {
+    GameJournal journal(FILE_NAME, BingoTypes::BINGO75);
+    EXPECT_EQ(journal.getNumEvents(), recorded.numEvents - 1);
+  }
+  EXPECT_EQ(readFile(FILE_NAME).size(),
+            recorded.numEvents * sizeof(GameJournal::event));
+  std::remove(FILE_NAME);
+}
+
+TEST(TestGameJournal, tornJoinTest) {
+  std::remove(FILE_NAME);
+  AnyLine victory;
+  BingoCardFactory factory;
+  Bingo75Caller caller(BingoTypes::ANY_LINE);
+  BingoGame game;
+  game.setCaller(&caller);
+  std::size_t numEvents;
+  {
+    GameJournal journal(FILE_NAME, BingoTypes::BINGO75);
+    game.setJournal(&journal);
+    game.joinGame("p0", factory.makeBingoCard(BingoTypes::BINGO75, &victory,
+                                              game.getCardArena()));
+    game.joinGame(LONG_ID, factory.makeBingoCard(BingoTypes::BINGO75,
+                                                 &victory,
+                                                 game.getCardArena()));
+    game.setJournal(nullptr);
+    numEvents = journal.getNumEvents();
+  }
+  // The write of the last ID_PART was torn.
+  std::string data = readFile(FILE_NAME);
+  data.resize(data.size() - sizeof(GameJournal::event) / 2);
+  writeFile(FILE_NAME, data);
+
+  Bingo75Caller replayCaller(BingoTypes::ANY_LINE);
+  BingoGame replayed;
+  replayed.setCaller(&replayCaller);
+  EXPECT_EQ(replayed.replayJournal(FILE_NAME), numEvents - 3);
+  EXPECT_EQ(replayed.getNumPlayers(), 1u);
+  EXPECT_TRUE(replayed.getPlayerHandle(LONG_ID) == BingoGame::NO_PLAYER);
+
+  {
+    GameJournal journal(FILE_NAME, BingoTypes::BINGO75);
+    EXPECT_EQ(journal.getNumEvents(), numEvents - 3);
+  }
+  EXPECT_EQ(readFile(FILE_NAME).size(),
+            (numEvents - 2) * sizeof(GameJournal::event));
+  std::remove(FILE_NAME);
+}
+
+TEST(TestGameJournal, settingsReplayTest) {
+  std::remove(FILE_NAME);
+  Blackout victory;
+  BingoCardFactory factory;
+  Bingo75Caller caller(BingoTypes::ANY_LINE);
+  BingoGame game;
+  game.setCaller(&caller);
+  game.setAutoDaub(false);
+  {
+    GameJournal journal(FILE_NAME, BingoTypes::BINGO75);
+    game.setJournal(&journal);
+    game.resetVictoryType(BingoTypes::BLACKOUT);
+    game.setAutoDaub(true);
+    game.joinGame("p0", factory.makeBingoCard(BingoTypes::BINGO75, &victory,
+                                              game.getCardArena()));
+    std::ostringstream out;
+    for (unsigned call = 0; call < 10; ++call) {
+      game.completeNextCall(out);
+    }
+    game.setJournal(nullptr);
+  }
+
+  // The replay starts with the defaults, the settings come from the
+  // journal, and the card is daubed by the game.
+  Bingo75Caller replayCaller(BingoTypes::ANY_LINE);
+  BingoGame replayed;
+  replayed.setCaller(&replayCaller);
+  replayed.setAutoDaub(false);
+  replayed.replayJournal(FILE_NAME);
+  std::remove(FILE_NAME);
+  EXPECT_EQ(replayed.getVictoryType(), BingoTypes::BLACKOUT);
+  EXPECT_TRUE(replayed.getAutoDaub());
+  EXPECT_EQ(showCard(replayed, 0), showCard(game, 0));
+  EXPECT_NE(showCard(replayed, 0).find('('), std::string::npos);
+}
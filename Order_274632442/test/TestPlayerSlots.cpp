@@ -0,0 +1,121 @@
+/**
+* @file TestPlayerSlots.cpp
+* @brief Tests of the slot table behind player handles.
+* @details Build from Order_274632442 with:
+*   g++ -std=c++17 -I. test/TestPlayerSlots.cpp BingoGame.cpp
+*   BingoCaller.cpp BingoCard.cpp BingoCardFactory.cpp CardArena.cpp
+*   CardBatch.cpp ClueTable.cpp DaubState.cpp EmbeddedClues.cpp
+*   FlatIdMap.cpp GameJournal.cpp MakeRandomInt.cpp MappedFile.cpp
+*   NumberIndex.cpp ScreenDisplay.cpp Square.cpp UserInput.cpp
+*   VictoryCondition.cpp -lgtest -lgtest_main -pthread -o testPlayerSlots
+*/
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "BingoCaller.h"
+#include "BingoCard.h"
+#include "BingoCardFactory.h"
+#include "BingoGame.h"
+#include "VictoryCondition.h"
+
+namespace {
+
+/**
+* @brief Call balls until player daubs a line and claims it, the claim is
+*   not answered until the next call.
+*/
+void playUntilClaim(BingoGame& game, BingoCaller& caller, BingoCard* card,
+                    BingoGame::playerHandle player, std::ostream& out) {
+  std::vector<BingoGame::actionResult> results;
+  while (caller.getNumBallsPulled() < caller.getNumBalls()) {
+    game.completeNextCall(out);
+    std::vector<BingoGame::packedAction> actions;
+    for (unsigned row = 1; row <= 5; ++row) {
+      for (unsigned col = 1; col <= 5; ++col) {
+        if (card->getSquare({row, col})->getValue()
+            == caller.getCurrentNumber()) {
+          actions.push_back(BingoGame::pack({player, BingoTypes::DAUB,
+                                             {row, col}}));
+        }
+      }
+    }
+    actions.push_back(BingoGame::pack({player, BingoTypes::BINGO, {0, 0}}));
+    game.takeActions(actions.data(), actions.size(), results);
+    if (results.back() == BingoGame::BINGO_MET) {
+      return;
+    }
+  }
+  FAIL() << "The card never met the victory conditions.";
+}
+
+}  // namespace
+
+TEST(TestPlayerSlots, claimLeaveJoinCallTest) {
+  AnyLine victory;
+  BingoCardFactory factory;
+  Bingo75Caller caller(BingoTypes::ANY_LINE);
+  caller.setGameStream(1, 1);
+  BingoGame game;
+  game.setCaller(&caller);
+  game.setAutoDaub(false);
+  game.joinGame("alice", factory.makeBingoCard(BingoTypes::BINGO75, &victory,
+                                               game.getCardArena()));
+  BingoCard* bob = factory.makeBingoCard(BingoTypes::BINGO75, &victory,
+                                         game.getCardArena());
+  game.joinGame("bob", bob);
+  std::ostringstream out;
+  playUntilClaim(game, caller, bob, game.getPlayerHandle("bob"), out);
+
+  EXPECT_TRUE(game.leaveGame("bob"));
+  game.joinGame("carol", factory.makeBingoCard(BingoTypes::BINGO75, &victory,
+                                               game.getCardArena()));
+  EXPECT_EQ(game.getPlayerHandle("carol"), 1u);
+  out.str("");
+  game.completeNextCall(out);
+  EXPECT_EQ(out.str().find("Bingo for"), std::string::npos);
+  EXPECT_EQ(game.getNumPlayers(), 2u);
+}
+
+TEST(TestPlayerSlots, claimLeaveCallTest) {
+  AnyLine victory;
+  BingoCardFactory factory;
+  Bingo75Caller caller(BingoTypes::ANY_LINE);
+  caller.setGameStream(1, 1);
+  BingoGame game;
+  game.setCaller(&caller);
+  game.setAutoDaub(false);
+  game.joinGame("alice", factory.makeBingoCard(BingoTypes::BINGO75, &victory,
+                                               game.getCardArena()));
+  BingoCard* bob = factory.makeBingoCard(BingoTypes::BINGO75, &victory,
+                                         game.getCardArena());
+  game.joinGame("bob", bob);
+  std::ostringstream out;
+  playUntilClaim(game, caller, bob, game.getPlayerHandle("bob"), out);
+
+  // Bob's slot is the last, so it is dropped from the table.
+  EXPECT_TRUE(game.leaveGame("bob"));
+  out.str("");
+  game.completeNextCall(out);
+  EXPECT_EQ(out.str().find("Bingo for"), std::string::npos);
+  EXPECT_EQ(game.getNumPlayers(), 1u);
+}
+
+TEST(TestPlayerSlots, holesAreReusedTest) {
+  AnyLine victory;
+  BingoCardFactory factory;
+  Bingo75Caller caller(BingoTypes::ANY_LINE);
+  BingoGame game;
+  game.setCaller(&caller);
+  for (const char* id : {"a", "b", "c"}) {
+    game.joinGame(id, factory.makeBingoCard(BingoTypes::BINGO75, &victory,
+                                            game.getCardArena()));
+  }
+  EXPECT_TRUE(game.leaveGame("b"));
+  EXPECT_EQ(game.getPlayerHandle("c"), 2u);
+  game.joinGame("d", factory.makeBingoCard(BingoTypes::BINGO75, &victory,
+                                           game.getCardArena()));
+  EXPECT_EQ(game.getPlayerHandle("d"), 1u);
+  EXPECT_EQ(game.getPlayerId(2), "c");
+}
@@ -0,0 +1,242 @@
+/**
+* @file TestSnapshot.cpp
+* @brief Tests of saving a game to a snapshot and restoring it.
+* @details The damaged files are made by finding a section's bytes in a
+*   saved file, see snapshotLayout in BingoGame.cpp. Build from
+*   Order_274632442 with:
+*   g++ -std=c++17 -I. test/TestSnapshot.cpp BingoGame.cpp
+*   BingoCaller.cpp BingoCard.cpp BingoCardFactory.cpp CardArena.cpp
+*   CardBatch.cpp ClueTable.cpp DaubState.cpp EmbeddedClues.cpp
+*   FlatIdMap.cpp GameJournal.cpp MakeRandomInt.cpp MappedFile.cpp
+*   NumberIndex.cpp ScreenDisplay.cpp Square.cpp UserInput.cpp
+*   VictoryCondition.cpp -lgtest -lgtest_main -pthread -o testSnapshot
+*/
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "BingoCaller.h"
+#include "BingoCard.h"
+#include "BingoCardFactory.h"
+#include "BingoGame.h"
+#include "VictoryCondition.h"
+#include "Exceptions.h"
+
+namespace {
+
+const char* FILE_NAME = "testSnapshot.bin";
+const unsigned NUM_CALLS = 5;
+
+/**
+* @brief Players p0 to p3 join, p1 and p2 leave, then balls are called and
+*   each player daubs every square of the ball.
+* @return The cards of the players, nullptr for those who left.
+*/
+std::vector<BingoCard*> playSome(BingoGame& game, BingoCaller& caller,
+                                 VictoryCondition& victory) {
+  BingoCardFactory factory;
+  std::vector<BingoCard*> cards;
+  for (unsigned i = 0; i < 4; ++i) {
+    cards.push_back(factory.makeBingoCard(BingoTypes::BINGO75, &victory,
+                                          game.getCardArena()));
+    game.joinGame("p" + std::to_string(i), cards.back());
+  }
+  game.leaveGame("p1");
+  game.leaveGame("p2");
+  cards[1] = cards[2] = nullptr;
+
+  std::ostringstream out;
+  std::vector<BingoGame::actionResult> results;
+  for (unsigned call = 0; call < NUM_CALLS; ++call) {
+    game.completeNextCall(out);
+    std::vector<BingoGame::packedAction> actions;
+    for (BingoGame::playerHandle player : {0u, 3u}) {
+      for (unsigned row = 1; row <= 5; ++row) {
+        for (unsigned col = 1; col <= 5; ++col) {
+          if (cards[player]->getSquare({row, col})->getValue()
+              == caller.getCurrentNumber()) {
+            actions.push_back(BingoGame::pack({player, BingoTypes::DAUB,
+                                               {row, col}}));
+          }
+        }
+      }
+    }
+    game.takeActions(actions.data(), actions.size(), results);
+  }
+  return cards;
+}
+
+std::string readFile(const char* fileName) {
+  std::ifstream in(fileName, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(in),
+                     std::istreambuf_iterator<char>());
+}
+
+void writeFile(const char* fileName, const std::string& data) {
+  std::ofstream out(fileName, std::ios::binary | std::ios::trunc);
+  out.write(data.data(), data.size());
+}
+
+std::string bytesOf(const void* data, std::size_t size) {
+  return std::string(static_cast<const char*>(data), size);
+}
+
+/**
+* @brief The offset of the free slots in a snapshot of playSome's game,
+*   found by the slot id ends and free slots saved one after the other.
+*/
+std::size_t freeSlotsOffset(const std::string& data) {
+  const std::uint32_t idEndsAndFree[] = {2, 2, 2, 4, 1, 2};
+  std::size_t offset = data.find(bytesOf(idEndsAndFree,
+                                         sizeof(idEndsAndFree)));
+  EXPECT_NE(offset, std::string::npos);
+  return offset + 4 * sizeof(std::uint32_t);
+}
+
+std::string showCard(BingoGame& game, BingoGame::playerHandle player) {
+  std::ostringstream out;
+  game.takeAction(out, {player, BingoTypes::SHOW_CARD, {0, 0}});
+  return out.str();
+}
+
+/**
+* @brief Restore a damaged file into a game with one player, which must be
+*   left as it was.
+*/
+void expectDamaged(const std::string& data) {
+  writeFile(FILE_NAME, data);
+  AnyLine victory;
+  BingoCardFactory factory;
+  Bingo75Caller caller(BingoTypes::ANY_LINE);
+  BingoGame game;
+  game.setCaller(&caller);
+  game.joinGame("zed", factory.makeBingoCard(BingoTypes::BINGO75, &victory,
+                                             game.getCardArena()));
+  EXPECT_THROW(game.restoreSnapshot(FILE_NAME), bad_input);
+  EXPECT_EQ(game.getNumPlayers(), 1u);
+  EXPECT_EQ(game.getPlayerId(0), "zed");
+  EXPECT_EQ(caller.getNumBallsPulled(), 0u);
+  std::remove(FILE_NAME);
+}
+
+}  // namespace
+
+TEST(TestSnapshot, saveRestoreContinueTest) {
+  AnyLine victory;
+  Bingo75Caller caller(BingoTypes::ANY_LINE);
+  caller.setGameStream(7, 1);
+  BingoGame game;
+  game.setCaller(&caller);
+  game.setAutoDaub(false);
+  playSome(game, caller, victory);
+  game.saveSnapshot(FILE_NAME);
+
+  Bingo75Caller restoredCaller(BingoTypes::HORIZONTAL_LINE);
+  BingoGame restored;
+  restored.setCaller(&restoredCaller);
+  restored.restoreSnapshot(FILE_NAME);
+  std::remove(FILE_NAME);
+
+  EXPECT_EQ(restored.getNumPlayers(), 2u);
+  EXPECT_EQ(restored.getVictoryType(), BingoTypes::ANY_LINE);
+  EXPECT_EQ(restored.getPlayerHandle("p3"), 3u);
+  EXPECT_TRUE(restored.getPlayerHandle("p1") == BingoGame::NO_PLAYER);
+  EXPECT_EQ(restoredCaller.getNumBallsPulled(), NUM_CALLS);
+  EXPECT_EQ(restoredCaller.getCurrentNumber(), caller.getCurrentNumber());
+  EXPECT_EQ(showCard(restored, 0), showCard(game, 0));
+  EXPECT_EQ(showCard(restored, 3), showCard(game, 3));
+
+  // Both games draw the same balls and reuse the same free slot.
+  BingoCardFactory factory;
+  EXPECT_TRUE(restored.joinGame("p4", factory.makeBingoCard(
+    BingoTypes::BINGO75, &victory, restored.getCardArena())));
+  EXPECT_TRUE(game.joinGame("p4", factory.makeBingoCard(
+    BingoTypes::BINGO75, &victory, game.getCardArena())));
+  EXPECT_EQ(restored.getPlayerHandle("p4"), game.getPlayerHandle("p4"));
+  for (unsigned call = 0; call < 10; ++call) {
+    std::ostringstream out, restoredOut;
+    game.completeNextCall(out);
+    restored.completeNextCall(restoredOut);
+    EXPECT_EQ(restoredOut.str(), out.str());
+  }
+  EXPECT_TRUE(restored.leaveGame("p0"));
+  EXPECT_EQ(restored.getNumPlayers(), 2u);
+}
+
+TEST(TestSnapshot, duplicateFreeSlotTest) {
+  AnyLine victory;
+  Bingo75Caller caller(BingoTypes::ANY_LINE);
+  BingoGame game;
+  game.setCaller(&caller);
+  playSome(game, caller, victory);
+  game.saveSnapshot(FILE_NAME);
+  std::string data = readFile(FILE_NAME);
+
+  // Slot 1 twice, and slot 2 not at all.
+  const std::uint32_t slot = 1;
+  data.replace(freeSlotsOffset(data) + 4, 4, bytesOf(&slot, 4));
+  expectDamaged(data);
+}
+
+TEST(TestSnapshot, swappedCardsTest) {
+  AnyLine victory;
+  Bingo75Caller caller(BingoTypes::ANY_LINE);
+  BingoGame game;
+  game.setCaller(&caller);
+  std::vector<BingoCard*> cards = playSome(game, caller, victory);
+  game.saveSnapshot(FILE_NAME);
+  std::string data = readFile(FILE_NAME);
+
+  // Each card is valid, but the postings lead to the other card's values.
+  std::string first = bytesOf(cards[0], sizeof(BingoCard));
+  std::string last = bytesOf(cards[3], sizeof(BingoCard));
+  std::size_t firstOffset = data.find(first);
+  std::size_t lastOffset = data.find(last);
+  ASSERT_NE(firstOffset, std::string::npos);
+  ASSERT_NE(lastOffset, std::string::npos);
+  data.replace(firstOffset, first.size(), last);
+  data.replace(lastOffset, last.size(), first);
+  expectDamaged(data);
+}
+
+TEST(TestSnapshot, cardOfAnotherGameTest) {
+  AnyLine victory;
+  Bingo75Caller caller(BingoTypes::ANY_LINE);
+  BingoGame game;
+  game.setCaller(&caller);
+  std::vector<BingoCard*> cards = playSome(game, caller, victory);
+  game.saveSnapshot(FILE_NAME);
+  std::string data = readFile(FILE_NAME);
+
+  BingoCardFactory factory;
+  BingoCard* card = factory.makeBingoCard(BingoTypes::BINGO50, &victory);
+  std::string saved = bytesOf(cards[0], sizeof(BingoCard));
+  std::size_t offset = data.find(saved);
+  ASSERT_NE(offset, std::string::npos);
+  data.replace(offset, saved.size(), bytesOf(card, sizeof(BingoCard)));
+  delete card;
+  expectDamaged(data);
+}
+
+TEST(TestSnapshot, postingOutsideCardTest) {
+  AnyLine victory;
+  Bingo75Caller caller(BingoTypes::ANY_LINE);
+  BingoGame game;
+  game.setCaller(&caller);
+  playSome(game, caller, victory);
+  game.saveSnapshot(FILE_NAME);
+  std::string data = readFile(FILE_NAME);
+
+  // No claims are pending, so the 75 posting counts follow the two free
+  // slots, then the postings of each {card, location}.
+  std::size_t postings = freeSlotsOffset(data) + (2 + 75) * 4;
+  const std::uint32_t location = 25;
+  data.replace(postings + 4, 4, bytesOf(&location, 4));
+  expectDamaged(data);
+}
@@ -0,0 +1,134 @@
+/**
+* @file EmbedClues.cpp
+* @brief Generates EmbeddedClues.cpp, the clue packs compiled into the
+*   program, from clues files.
+* @details Each file is checked with ClueTable::readFile, so a pack is
+*   embedded only if the caller would accept its file. The pack is named
+*   after the file, without the directory or the extension. Build and run
+*   from Order_274632442 with:
+*   g++ -std=c++17 -I. tools/EmbedClues.cpp ClueTable.cpp MappedFile.cpp
+*   -o embedClues
+*   ./embedClues 50 EmbeddedClues.cpp src/csv/bingo50calls.csv
+*   src/csv/bingo50clues.csv
+*/
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ClueTable.h"
+#include "Exceptions.h"
+
+// The generator embeds no packs itself, it writes the packs of the program.
+const ClueTable::Pack ClueTable::PACKS[1] = {};
+const unsigned ClueTable::NUM_PACKS = 0;
+
+namespace {
+
+std::string packName(const std::string& fileName) {
+  std::string name = fileName.substr(fileName.find_last_of('/') + 1);
+  return name.substr(0, name.find('.'));
+}
+
+std::string identifier(const std::string& name) {
+  std::string result;
+  for (char c : name) {
+    if (c >= 'a' && c <= 'z') {
+      result += c - 'a' + 'A';
+    } else if ((c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')) {
+      result += c;
+    } else {
+      result += '_';
+    }
+  }
+  return result;
+}
+
+std::string quote(std::string_view text) {
+  std::string result = "\"";
+  for (char c : text) {
+    if (c == '"' || c == '\\') {
+      result += '\\';
+      result += c;
+    } else if (c < ' ' || c > '~') {
+      char escape[8];
+      std::snprintf(escape, sizeof(escape), "\\%03o",
+                    static_cast<unsigned char>(c));
+      result += escape;
+    } else {
+      result += c;
+    }
+  }
+  return result + "\"";
+}
+
+void writePack(std::ostream& out, const std::string& name,
+               const ClueTable& table) {
+  std::string id = identifier(name);
+  unsigned numValues = table.getNumValues();
+  unsigned numClues = table.getNumClues();
+
+  out << "constexpr std::uint32_t " << id << "_OFFSETS[] = {";
+  std::uint32_t offset = 0;
+  for (unsigned i = 0; i <= numValues * numClues; ++i) {
+    out << (i % 10 == 0 ? "\n  " : " ") << offset << ',';
+    if (i < numValues * numClues) {
+      offset += table.getClue(i / numClues + 1, i % numClues).size();
+    }
+  }
+  out << "\n};\n\n";
+
+  out << "constexpr char " << id << "_TEXT[] =";
+  for (unsigned value = 1; value <= numValues; ++value) {
+    std::string line;
+    for (unsigned clue = 0; clue < numClues; ++clue) {
+      line += table.getClue(value, clue);
+    }
+    out << "\n  " << quote(line);
+  }
+  out << ";\n\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc < 4) {
+    std::cerr << "usage: " << argv[0]
+              << " numValues output.cpp clues.csv...\n";
+    return 2;
+  }
+  unsigned numValues = std::stoul(argv[1]);
+
+  std::vector<std::string> names;
+  std::vector<ClueTable> tables;
+  try {
+    for (int i = 3; i < argc; ++i) {
+      names.push_back(packName(argv[i]));
+      tables.push_back(ClueTable::readFile(argv[i], numValues));
+    }
+  } catch (const bad_input& e) {
+    std::cerr << e.what() << '\n';
+    return 1;
+  }
+
+  std::ofstream out(argv[2]);
+  out << "// Generated by tools/EmbedClues.cpp, do not edit.\n"
+      << "\n#include <cstdint>\n\n#include \"ClueTable.h\"\n"
+      << "\nnamespace {\n\n";
+  for (unsigned i = 0; i < tables.size(); ++i) {
+    writePack(out, names[i], tables[i]);
+  }
+  out << "}  // namespace\n\nconst ClueTable::Pack ClueTable::PACKS[] = {";
+  for (unsigned i = 0; i < tables.size(); ++i) {
+    std::string id = identifier(names[i]);
+    out << "\n  {" << quote(names[i]) << ", " << tables[i].getNumValues()
+        << ", " << tables[i].getNumClues() << ",\n   " << id
+        << "_OFFSETS, " << id << "_TEXT},";
+  }
+  out << "\n};\n\nconst unsigned ClueTable::NUM_PACKS = "
+      << tables.size() << ";\n";
+  return out ? 0 : 1;
+}